@@ -6,16 +6,29 @@ file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 #pragma once
 
+#include <cstdint>
+#include <span>
+
+#include "EZ-Template/fixed_q16.hpp"
+#include "EZ-Template/pid_telemetry.hpp"
 #include "EZ-Template/util.hpp"
 #include "api.h"
 
 namespace ez {
-class PID {
+/**
+ * PID controller.
+ *
+ * Scalar is the number type used for constants and the math in compute().  ez::PID uses double,
+ * ez::PID_float uses float, and ez::PID_fixed uses Q16.16 fixed point.  Exit conditions are the
+ * same for all of them.
+ */
+template <typename Scalar>
+class PID_T {
  public:
   /**
    * Default constructor.
    */
-  PID();
+  PID_T();
 
   /**
    * Constructor with constants.
@@ -31,7 +44,7 @@ class PID {
    * \param name
    *        std::string of name that prints
    */
-  PID(double p, double i = 0, double d = 0, double start_i = 0, std::string name = "");
+  PID_T(Scalar p, Scalar i = 0, Scalar d = 0, Scalar start_i = 0, std::string name = "");
 
   /**
    * Set constants for PID.
@@ -45,16 +58,49 @@ class PID {
    * \param p_start_i
    *        error value that i starts within
    */
-  void constants_set(double p, double i = 0, double d = 0, double p_start_i = 0);
+  void constants_set(Scalar p, Scalar i = 0, Scalar d = 0, Scalar p_start_i = 0);
 
   /**
    * Struct for constants.
    */
   struct Constants {
-    double kp;
-    double ki;
-    double kd;
-    double start_i;
+    Scalar kp;
+    Scalar ki;
+    Scalar kd;
+    Scalar start_i;
+  };
+
+  /**
+   * Max amount of points in a gain schedule.
+   */
+  static const int GAIN_SCHEDULE_MAX = 8;
+
+  /**
+   * Struct for a point in a gain schedule.
+   */
+  struct Gains {
+    Scalar breakpoint = 0;
+    Scalar kp = 0;
+    Scalar ki = 0;
+    Scalar kd = 0;
+  };
+
+  /**
+   * Struct for a gain schedule.  Points are sorted by breakpoint.
+   */
+  struct GainSchedule {
+    Gains points[GAIN_SCHEDULE_MAX];
+    int size = 0;
+    e_gain_schedule input = GAIN_SCHEDULE_ERROR;
+  };
+
+  /**
+   * Struct for feedforward constants.
+   */
+  struct Feedforward {
+    Scalar ks = 0;
+    Scalar kv = 0;
+    Scalar ka = 0;
   };
 
   /**
@@ -91,7 +137,7 @@ class PID {
    * \param target
    *        new target for PID
    */
-  void target_set(double input);
+  void target_set(Scalar input);
 
   /**
    * Computes PID.
@@ -99,7 +145,7 @@ class PID {
    * \param current
    *        current sensor value
    */
-  double compute(double current);
+  Scalar compute(Scalar current);
 
   /**
    * Computes PID, but you compute the error yourself.
@@ -111,12 +157,169 @@ class PID {
    * \param current
    *        current sensor value
    */
-  double compute_error(double err, double current);
+  Scalar compute_error(Scalar err, Scalar current);
+
+  /**
+   * Computes PID using the real time since the last compute.
+   *
+   * Gains are tuned for util::DELAY_TIME, so i and d are scaled by how long it actually was.
+   * The first compute, or one after a gap longer than 4 periods, is treated as 1 period.  See period_set().
+   *
+   * \param current
+   *        current sensor value
+   * \param time_us
+   *        time this sensor value was read, in microseconds (pros::micros())
+   */
+  Scalar compute(Scalar current, std::uint64_t time_us);
+
+  /**
+   * Computes PID using the real time since the last compute, but you compute the error yourself.
+   *
+   * \param err
+   *        error for the PID, you need to calculate this yourself
+   * \param current
+   *        current sensor value
+   * \param time_us
+   *        time this sensor value was read, in microseconds (pros::micros())
+   */
+  Scalar compute_error(Scalar err, Scalar current, std::uint64_t time_us);
+
+  /**
+   * Sets how often compute() with a time is called, in ms.
+   *
+   * Only used to decide when a gap is too long to trust, gains are still tuned for util::DELAY_TIME.
+   *
+   * \param period
+   *        ms between computes
+   */
+  void period_set(int period);
+
+  /**
+   * Returns how often compute() with a time is called, in ms.
+   */
+  int period_get();
+
+  /**
+   * Adds a point to the gain schedule.
+   *
+   * While the schedule has points, kp, ki and kd come from the schedule instead of constants.  Between points
+   * gains are linearly interpolated, and past the first or last point the closest point is used.
+   *
+   * Returns false if the schedule is full.
+   *
+   * \param breakpoint
+   *        error or speed (from gain_schedule_input_set()) these gains are used at
+   * \param kp
+   *        kP
+   * \param ki
+   *        ki
+   * \param kd
+   *        kD
+   */
+  bool gain_schedule_add(Scalar breakpoint, Scalar kp, Scalar ki = 0, Scalar kd = 0);
+
+  /**
+   * Removes every point from the gain schedule, going back to normal constants.
+   */
+  void gain_schedule_clear();
+
+  /**
+   * Sets what the gain schedule looks up gains with.
+   *
+   * \param input
+   *        GAIN_SCHEDULE_ERROR uses the size of error, GAIN_SCHEDULE_SPEED uses the size of derivative
+   */
+  void gain_schedule_input_set(e_gain_schedule input);
+
+  /**
+   * Returns true if the gain schedule has points.
+   */
+  bool gain_schedule_enabled();
+
+  /**
+   * Returns the gains the schedule uses at a value.  start_i comes from constants.
+   *
+   * \param input
+   *        error or speed to look up
+   */
+  Constants gain_schedule_get(Scalar input);
+
+  /**
+   * Sets feedforward constants.  These get added to the PID output using the reference from reference_set().
+   *
+   * \param ks
+   *        output to overcome static friction, added in the direction of reference velocity
+   * \param kv
+   *        output per unit of reference velocity
+   * \param ka
+   *        output per unit of reference acceleration
+   */
+  void feedforward_constants_set(Scalar ks, Scalar kv = 0, Scalar ka = 0);
+
+  /**
+   * Returns feedforward constants.
+   */
+  Feedforward feedforward_constants_get();
+
+  /**
+   * Returns true if feedforward constants are set, returns false if they're all 0.
+   */
+  bool feedforward_set_check();
+
+  /**
+   * Sets the velocity and acceleration the mechanism should be moving at right now, usually from a motion profile.
+   *
+   * \param velocity
+   *        reference velocity, in sensor units per second
+   * \param acceleration
+   *        reference acceleration, in sensor units per second squared
+   */
+  void reference_set(Scalar velocity, Scalar acceleration = 0);
+
+  /**
+   * Sets where the mechanism should be right now, usually from a motion profile.
+   * P and I use the error to this instead of the target, exit conditions still use the target.
+   *
+   * \param position
+   *        reference position, in sensor units
+   */
+  void reference_position_set(Scalar position);
+
+  /**
+   * Stops using a reference position, P and I go back to using the target.
+   */
+  void reference_position_clear();
+
+  /**
+   * Sets a low pass filter on derivative.  This smooths out noisy sensors.
+   *
+   * \param time_constant
+   *        time constant of the filter in ms, 0 disables it
+   */
+  void derivative_filter_set(Scalar time_constant);
+
+  /**
+   * Returns the time constant of the derivative filter in ms.  0 is disabled.
+   */
+  Scalar derivative_filter_get();
+
+  /**
+   * Sets the largest value integral can build up to, in either direction.
+   *
+   * \param max
+   *        largest integral, 0 disables it
+   */
+  void integral_limit_set(Scalar max);
+
+  /**
+   * Returns the largest value integral can build up to.  0 is disabled.
+   */
+  Scalar integral_limit_get();
 
   /**
    * Returns target value.
    */
-  double target_get();
+  Scalar target_get();
 
   /**
    * Returns constants.
@@ -143,6 +346,16 @@ class PID {
    */
   exit_condition_ exit;
 
+  /**
+   * Feedforward constants.
+   */
+  Feedforward feedforward;
+
+  /**
+   * Gain schedule.
+   */
+  GainSchedule schedule;
+
   /**
    * Updates a secondary sensor for velocity exiting.  Ideal use is IMU during normal drive motions.
    *
@@ -211,7 +424,7 @@ class PID {
    * \param print = false
    *        if true, prints when complete
    */
-  ez::exit_output exit_condition(pros::Motor sensor, bool print = false);
+  ez::exit_output exit_condition(const pros::Motor& sensor, bool print = false);
 
   /**
    * Iterative exit condition for PID.
@@ -221,7 +434,7 @@ class PID {
    * \param print = false
    *        if true, prints when complete
    */
-  ez::exit_output exit_condition(std::vector<pros::Motor> sensor, bool print = false);
+  ez::exit_output exit_condition(const std::vector<pros::Motor>& sensor, bool print = false);
 
   /**
    * Iterative exit condition for PID.
@@ -231,7 +444,36 @@ class PID {
    * \param print = false
    *        if true, prints when complete
    */
-  ez::exit_output exit_condition(pros::MotorGroup sensor, bool print = false);
+  ez::exit_output exit_condition(const pros::MotorGroup& sensor, bool print = false);
+
+  /**
+   * Iterative exit condition for PID.
+   *
+   * Motors are read by port, so nothing gets copied or allocated.
+   *
+   * \param ports
+   *        ports of the motors on your mechanism
+   * \param print = false
+   *        if true, prints when complete
+   */
+  ez::exit_output exit_condition(std::span<const std::int8_t> ports, bool print = false);
+
+  /**
+   * Iterative exit condition for PID.
+   *
+   * Use this when the motors have already been read this loop.
+   *
+   * \param over_current
+   *        true for each motor on your mechanism that's over its current limit
+   * \param print = false
+   *        if true, prints when complete
+   */
+  ez::exit_output exit_condition(std::span<const bool> over_current, bool print = false);
+
+  /**
+   * A bool array would turn into exit_condition(bool print), wrap it in a std::span instead.
+   */
+  ez::exit_output exit_condition(const bool* over_current, bool print = false) = delete;
 
   /**
    * Sets the name of the PID that prints during exit conditions.
@@ -268,19 +510,47 @@ class PID {
    */
   void timers_reset();
 
+  /**
+   * Records every compute so it can be saved later.  Memory is allocated here, so nothing is allocated while recording.
+   *
+   * \param samples
+   *        amount of computes to keep, once full the oldest is overwritten.  0 disables recording.
+   */
+  void telemetry_enable(int samples);
+
+  /**
+   * Returns what's been recorded.
+   */
+  const pid_telemetry& telemetry_get();
+
+  /**
+   * Saves what's been recorded to a binary file that ez::pid_telemetry_read() can read.
+   *
+   * This can be called while the PID is computing, samples computed while they're being copied aren't kept.
+   * Returns false if the file couldn't be written.
+   *
+   * \param path
+   *        file to write to, like "/usd/turn_pid.bin"
+   */
+  bool telemetry_save(std::string path);
+
   /**
    * PID variables.
    */
-  double output = 0.0;
-  double cur = 0.0;
-  double error = 0.0;
-  double target = 0.0;
-  double prev_error = 0.0;
-  double prev_current = 0.0;
-  double integral = 0.0;
-  double derivative = 0.0;
-  long time = 0;
-  long prev_time = 0;
+  Scalar output = 0.0;
+  Scalar cur = 0.0;
+  Scalar error = 0.0;
+  Scalar target = 0.0;
+  Scalar prev_error = 0.0;
+  Scalar prev_current = 0.0;
+  Scalar integral = 0.0;
+  Scalar derivative = 0.0;
+  Scalar reference_velocity = 0.0;
+  Scalar reference_acceleration = 0.0;
+  Scalar reference_position = 0.0;
+  bool reference_position_enabled = false;
+  std::uint64_t time = 0;
+  std::uint64_t prev_time = 0;
 
  private:
   double velocity_zero_main = 0.05;
@@ -292,8 +562,23 @@ class PID {
   std::string name;
   bool name_active = false;
   void exit_condition_print(ez::exit_output exit_type);
+  ez::exit_output exit_condition_mA(bool over_current, bool print);
   bool reset_i_sgn = true;
-  double raw_compute();
+  Scalar raw_compute(Scalar dt_scale = 1, std::uint64_t time_us = 0);
+  pid_telemetry telemetry;
+  Scalar derivative_time_constant = 0;
+  Scalar integral_max = 0;
+  int exit_dt = util::DELAY_TIME;
+  int period = util::DELAY_TIME;
   bool use_second_sensor = false;
 };
+
+using PID = PID_T<double>;
+using PID_float = PID_T<float>;
+using PID_fixed = PID_T<fixed_q16>;
+
+// These are compiled once in PID.cpp
+extern template class PID_T<double>;
+extern template class PID_T<float>;
+extern template class PID_T<fixed_q16>;
 };  // namespace ez
\ No newline at end of file
@@ -10,8 +10,16 @@ file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include "EZ-Template/auton.hpp"
 #include "EZ-Template/auton_selector.hpp"
 #include "EZ-Template/drive/drive.hpp"
+#include "EZ-Template/fixed_q16.hpp"
+#include "EZ-Template/odom_tracker.hpp"
+#include "EZ-Template/pid_telemetry.hpp"
 #include "EZ-Template/piston.hpp"
+#include "EZ-Template/pose.hpp"
+#include "EZ-Template/profiler.hpp"
+#include "EZ-Template/relay_autotuner.hpp"
 #include "EZ-Template/sdcard.hpp"
 #include "EZ-Template/slew.hpp"
 #include "EZ-Template/tracking_wheel.hpp"
-#include "EZ-Template/util.hpp"
\ No newline at end of file
+#include "EZ-Template/trapezoid_profile.hpp"
+#include "EZ-Template/util.hpp"
+#include "EZ-Template/wall_localizer.hpp"
\ No newline at end of file
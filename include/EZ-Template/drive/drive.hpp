@@ -11,12 +11,20 @@ file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include <tuple>
 
 #include "EZ-Template/PID.hpp"
+#include "EZ-Template/drive/motion_handle.hpp"
+#include "EZ-Template/odom_tracker.hpp"
+#include "EZ-Template/profiler.hpp"
+#include "EZ-Template/relay_autotuner.hpp"
+#include "EZ-Template/seqlock.hpp"
 #include "EZ-Template/slew.hpp"
 #include "EZ-Template/tracking_wheel.hpp"
+#include "EZ-Template/trapezoid_profile.hpp"
 #include "EZ-Template/util.hpp"
+#include "EZ-Template/wall_localizer.hpp"
 #include "okapi/api/units/QAngle.hpp"
 #include "okapi/api/units/QLength.hpp"
 #include "okapi/api/units/QTime.hpp"
+#include "pros/distance.hpp"
 #include "pros/motor_group.hpp"
 #include "pros/motors.h"
 
@@ -142,6 +150,12 @@ class Drive {
   ez::slew slew_swing_backward;
   ez::slew slew_swing;
 
+  /**
+   * Motion profiles used for feedforward.
+   */
+  ez::trapezoid_profile drive_profile;
+  ez::trapezoid_profile turn_profile;
+
   /**
    * Sets constants for slew for swing movements.
    *
@@ -386,6 +400,150 @@ class Drive {
    */
   pros::Task ez_auto;
 
+  /**
+   * Task for odometry.  This runs at a higher priority than the autonomous task.
+   */
+  pros::Task ez_odom;
+
+  /**
+   * Task for wall localization.  This runs at a lower priority than the autonomous task.
+   */
+  pros::Task ez_localize;
+
+  /**
+   * Struct for timing of a fixed rate task.
+   *
+   * Jitter is how far the start of a tick was from where it should have been, in microseconds.
+   */
+  struct task_timing {
+    int period = 0;
+    int ticks = 0;
+    int missed_deadlines = 0;
+    double jitter_last = 0.0;
+    double jitter_min = 0.0;
+    double jitter_max = 0.0;
+    double jitter_mean = 0.0;
+  };
+
+  /**
+   * Sets the period of the autonomous task.  This defaults to 10ms.
+   *
+   * The task wakes up on absolute deadlines, so time spent running odom and PID does not stretch the period.
+   *
+   * \param period
+   *        period in ms
+   */
+  void drive_task_period_set(int period);
+
+  /**
+   * Sets the period of the autonomous task.  This defaults to 10ms.
+   *
+   * The task wakes up on absolute deadlines, so time spent running odom and PID does not stretch the period.
+   *
+   * \param p_period
+   *        period, okapi unit
+   */
+  void drive_task_period_set(okapi::QTime p_period);
+
+  /**
+   * Returns the period of the autonomous task in ms.
+   */
+  int drive_task_period_get();
+
+  /**
+   * Returns timing information for the autonomous task, including missed deadlines and jitter.
+   */
+  task_timing drive_task_timing_get();
+
+  /**
+   * Resets timing information for the autonomous task.
+   */
+  void drive_task_timing_reset();
+
+  /**
+   * Returns how long a stage of the autonomous task takes, in microseconds.
+   *
+   * This only collects data when EZ-Template is built with EZ_TEMPLATE_PROFILING set to 1.
+   *
+   * \param stage
+   *        the stage to get, STAGE_TICK is the whole tick
+   */
+  stage_timer::stats drive_task_stage_get(e_stage stage);
+
+  /**
+   * Resets timing stats for every stage of the autonomous task.
+   */
+  void drive_task_stages_reset();
+
+  /**
+   * Prints timing stats for every stage of the autonomous task to the terminal.
+   */
+  void drive_task_stages_print();
+
+  /**
+   * Prints timing stats for every stage of the autonomous task to the terminal every period.
+   *
+   * Printing happens at the end of a tick inside of the autonomous task, so that tick will run long.
+   *
+   * \param period
+   *        time between prints in ms, 0 disables this
+   */
+  void drive_task_stages_print_period_set(int period);
+
+  /**
+   * Sets the period of the odometry task.  This defaults to 5ms to match the IMU data rate.
+   *
+   * \param period
+   *        period in ms
+   */
+  void odom_task_period_set(int period);
+
+  /**
+   * Sets the period of the odometry task.  This defaults to 5ms to match the IMU data rate.
+   *
+   * \param p_period
+   *        period, okapi unit
+   */
+  void odom_task_period_set(okapi::QTime p_period);
+
+  /**
+   * Returns the period of the odometry task in ms.
+   */
+  int odom_task_period_get();
+
+  /**
+   * Returns timing information for the odometry task, including missed deadlines and jitter.
+   */
+  task_timing odom_task_timing_get();
+
+  /**
+   * Struct for every sensor the chassis uses in one tick.  Distances are in inches and angles are in degrees.
+   *
+   * Trackers that aren't enabled read 0.
+   */
+  struct sensor_frame {
+    std::uint64_t time = 0;  // pros::micros() when this was sampled
+    double left = 0.0;
+    double right = 0.0;
+    double tracker_left = 0.0;
+    double tracker_right = 0.0;
+    double tracker_front = 0.0;
+    double tracker_back = 0.0;
+    double imu = 0.0;
+    double imu_accel = 0.0;
+    bool left_over_current = false;
+    bool right_over_current = false;
+    pose odom = {0.0, 0.0, 0.0};  // Pose from the odometry task at the start of the tick
+    pose odom_predicted = {0.0, 0.0, 0.0};  // odom moved forward by odom_latency_compensation_set(), used to steer odom motions
+  };
+
+  /**
+   * Returns the sensors the autonomous task used on its last tick.
+   *
+   * Sensors are only sampled while a motion is running, so this doesn't update while the drive mode is DISABLE.
+   */
+  sensor_frame drive_sensor_frame_get();
+
   /**
    * Creates a Drive Controller using internal encoders.
    *
@@ -654,6 +812,322 @@ class Drive {
    */
   pose odom_pose_get();
 
+  /**
+   * Returns the pose of the robot at a time in the past, for sensors that take a while to measure.
+   *
+   * Odometry keeps its last ODOM_HISTORY_SIZE poses and this interpolates between the two closest to time.
+   * Times before the oldest pose return the oldest, and times after the newest return the newest.
+   * History is cleared when odometry is set.
+   *
+   * \param time
+   *        time in microseconds, from pros::micros()
+   */
+  pose odom_pose_at(std::uint64_t time);
+
+  /**
+   * Returns where the robot will be after some time, if it keeps moving the way it has been.
+   *
+   * Speed and turn rate come from the last 30ms of pose history.
+   *
+   * \param latency
+   *        time to look ahead in ms
+   */
+  pose odom_pose_predict(int latency);
+
+  /**
+   * Sets how far ahead odom motions look when steering, to make up for the time it takes motors to react.
+   *
+   * Odom motions steer with odom_pose_predict() of this instead of the current pose, which stops overshooting and
+   * oscillating at high speeds.  Exit conditions still use the current pose.
+   *
+   * \param latency
+   *        time in ms, 0 disables this.  Defaults to 0
+   */
+  void odom_latency_compensation_set(int latency);
+
+  /**
+   * Sets how far ahead odom motions look when steering, to make up for the time it takes motors to react.
+   *
+   * \param p_latency
+   *        time, okapi unit.  0 disables this
+   */
+  void odom_latency_compensation_set(okapi::QTime p_latency);
+
+  /**
+   * Returns how far ahead odom motions look when steering, in ms.
+   */
+  int odom_latency_compensation_get();
+
+  /**
+   * Amount of poses odometry remembers for odom_pose_at().
+   */
+  static const int ODOM_HISTORY_SIZE = 128;
+
+  /**
+   * Sets the math odometry uses to turn sensor changes into a new pose.
+   *
+   * Both are always computed, this only picks which one is used.
+   *
+   * \param integrator
+   *        ODOM_ARC moves along an arc using the change in each sensor.  ODOM_EXPONENTIAL uses the SE(2) exponential map
+   *        of how the robot moved, with a series expansion when it barely turned.  ODOM_LEAST_SQUARES uses every
+   *        tracking wheel, the drive's sensors and the IMU together, finding the movement that best fits all of them
+   */
+  void odom_integrator_set(e_odom_integrator integrator);
+
+  /**
+   * Returns the math odometry uses to turn sensor changes into a new pose.
+   */
+  e_odom_integrator odom_integrator_get();
+
+  /**
+   * Returns the pose from one integrator, even if it's not the one being used.  This is useful for comparing them.
+   *
+   * \param integrator
+   *        ODOM_ARC, ODOM_EXPONENTIAL or ODOM_LEAST_SQUARES
+   */
+  pose odom_integrator_pose_get(e_odom_integrator integrator);
+
+  /**
+   * How much each kind of sensor is trusted with ODOM_LEAST_SQUARES.
+   */
+  struct least_squares_weights {
+    double tracker = 1.0;  // tracking wheels set with odom_tracker_*_set()
+    double ime = 0.5;      // the drive's left and right sensors, when they aren't tracking wheels
+    double imu = 100.0;    // the IMU's change in heading
+  };
+
+  /**
+   * Sets how much each kind of sensor is trusted with ODOM_LEAST_SQUARES.
+   *
+   * Drive wheels slip more than tracking wheels, so they should be trusted less.  0 ignores that kind of sensor.
+   * The IMU reads an angle while wheels read a distance, so its weight is much bigger.
+   *
+   * \param tracker
+   *        weight of tracking wheels set with odom_tracker_*_set(), defaults to 1
+   * \param ime
+   *        weight of the drive's left and right sensors, defaults to 0.5
+   * \param imu
+   *        weight of the IMU, defaults to 100
+   */
+  void odom_least_squares_weights_set(double tracker, double ime, double imu);
+
+  /**
+   * Returns how much each kind of sensor is trusted with ODOM_LEAST_SQUARES.
+   */
+  least_squares_weights odom_least_squares_weights_get();
+
+  /**
+   * Adds another tracking wheel for ODOM_LEAST_SQUARES, at any spot and angle.
+   *
+   * Tracking wheels set with odom_tracker_*_set() are already used, this is for anything extra.
+   *
+   * \param input
+   *        an ez::tracking_wheel
+   * \param x
+   *        inches to the right of the center of the robot
+   * \param y
+   *        inches forwards of the center of the robot
+   * \param angle
+   *        direction the wheel reads positive, degrees clockwise from forwards
+   * \param weight
+   *        how much this wheel is trusted, defaults to 1
+   */
+  void odom_least_squares_tracker_add(tracking_wheel* input, double x, double y, double angle, double weight = 1.0);
+
+  /**
+   * Sets where odometry gets its heading from.
+   *
+   * \param heading
+   *        ODOM_HEADING_IMU uses the IMU.  ODOM_HEADING_FUSED learns how fast the IMU drifts by comparing it to the
+   *        left and right sensors while the robot is barely turning, and takes that drift out of the IMU.  This only
+   *        changes odometry, turns and swings still use the IMU.
+   */
+  void odom_heading_set(e_odom_heading heading);
+
+  /**
+   * Returns where odometry gets its heading from.
+   */
+  e_odom_heading odom_heading_get();
+
+  /**
+   * Sets how long the fused heading takes to learn how fast the IMU drifts.
+   *
+   * A change in how fast the IMU drifts is 63% learned after the robot has been barely turning for this long,
+   * no matter what odom_task_period_set() is.  Longer is less affected by bumps, shorter follows drift faster.
+   *
+   * \param time
+   *        time constant in ms, defaults to 2000
+   */
+  void odom_heading_fusion_time_constant_set(int time);
+
+  /**
+   * Sets how long the fused heading takes to learn how fast the IMU drifts.
+   *
+   * A change in how fast the IMU drifts is 63% learned after the robot has been barely turning for this long,
+   * no matter what odom_task_period_set() is.  Longer is less affected by bumps, shorter follows drift faster.
+   *
+   * \param p_time
+   *        time constant, okapi unit
+   */
+  void odom_heading_fusion_time_constant_set(okapi::QTime p_time);
+
+  /**
+   * Returns how long the fused heading takes to learn how fast the IMU drifts, in ms.
+   */
+  int odom_heading_fusion_time_constant_get();
+
+  /**
+   * Sets the turn rate where the fused heading stops learning IMU drift.
+   *
+   * Drift is only learned while the IMU turns slower than this, and while the IMU and the left and right sensors
+   * disagree by less than this.  Slipping wheels and track width error only show up while turning.
+   *
+   * \param rate
+   *        degrees per second, defaults to 5
+   */
+  void odom_heading_fusion_gate_set(double rate);
+
+  /**
+   * Returns the turn rate where the fused heading stops learning IMU drift, in degrees per second.
+   */
+  double odom_heading_fusion_gate_get();
+
+  /**
+   * Starts recording every sensor odometry reads, so the same ticks can be replayed later with ez::odom_replay().
+   *
+   * Resets, pose sets and changes to trackers, widths and odom modes are recorded too.  Recording stops once
+   * it's full, or once the setup has changed ez::ODOM_RECORDING_CONFIG_MAX times.
+   *
+   * \param frames
+   *        max amount of frames to keep, one is used every odom tick.  0 stops recording and frees memory
+   */
+  void odom_recording_start(int frames);
+
+  /**
+   * Stops recording.  What's been recorded is kept until the next start.
+   */
+  void odom_recording_stop();
+
+  /**
+   * Returns true while odometry is being recorded.
+   */
+  bool odom_recording_running();
+
+  /**
+   * Saves the recording to a binary file that ez::odom_recording_read() can read.
+   *
+   * Odometry keeps running while the file is written, and frames recorded after this is called aren't saved.
+   * Returns false if there is no SD card or the file couldn't be written.
+   *
+   * \param path
+   *        file to write to, like "/usd/odom.bin"
+   */
+  bool odom_recording_save(std::string path);
+
+  /**
+   * Adds a distance sensor used to correct odometry against the field walls.
+   *
+   * \param input
+   *        a pros::Distance
+   * \param x
+   *        inches to the right of the center of the robot
+   * \param y
+   *        inches forwards of the center of the robot
+   * \param angle
+   *        direction the sensor faces, degrees clockwise from forwards
+   */
+  void odom_wall_sensor_add(pros::Distance* input, double x, double y, double angle);
+
+  /**
+   * Sets where the field walls are, in the same coordinates as odometry.  Defaults to a 144 inch field centered on 0, 0.
+   *
+   * \param min_x
+   *        x of the left wall
+   * \param min_y
+   *        y of the back wall
+   * \param max_x
+   *        x of the right wall
+   * \param max_y
+   *        y of the front wall
+   */
+  void odom_wall_field_set(double min_x, double min_y, double max_x, double max_y);
+
+  /**
+   * Enables / disables correcting odometry against the field walls.
+   *
+   * A lower priority task runs a particle filter with the distance sensors and pulls x and y towards what it finds.
+   * Setting x or y, or enabling this, starts the particles over around the current pose.
+   *
+   * \param input
+   *        true enables, false disables
+   */
+  void odom_wall_localization_enable(bool input);
+
+  /**
+   * Returns true if odometry is being corrected against the field walls.
+   */
+  bool odom_wall_localization_enabled();
+
+  /**
+   * Sets how much of the difference between odometry and the walls is corrected every update.
+   *
+   * \param blend
+   *        0 to 1, defaults to 0.2.  updates are every 50ms
+   */
+  void odom_wall_localization_blend_set(double blend);
+
+  /**
+   * Returns how much of the difference between odometry and the walls is corrected every update.
+   */
+  double odom_wall_localization_blend_get();
+
+  /**
+   * Sets how spread out the particles can be while still correcting odometry.  Nothing is corrected until they agree this well.
+   *
+   * \param spread
+   *        inches, defaults to 3
+   */
+  void odom_wall_localization_spread_max_set(double spread);
+
+  /**
+   * Returns how spread out the particles can be while still correcting odometry.
+   */
+  double odom_wall_localization_spread_max_get();
+
+  /**
+   * Sets how old a distance sensor reading is by the time it's read.  Each reading is matched with where odometry
+   * was this long before it was read.
+   *
+   * \param latency
+   *        ms, defaults to 33
+   */
+  void odom_wall_localization_latency_set(int latency);
+
+  /**
+   * Sets how old a distance sensor reading is by the time it's read.  Each reading is matched with where odometry
+   * was this long before it was read.
+   *
+   * \param p_latency
+   *        latency, okapi unit
+   */
+  void odom_wall_localization_latency_set(okapi::QTime p_latency);
+
+  /**
+   * Returns how old a distance sensor reading is by the time it's read, in ms.
+   */
+  int odom_wall_localization_latency_get();
+
+  /**
+   * Returns where the walls say the robot is.
+   */
+  pose odom_wall_localization_pose_get();
+
+  /**
+   * Returns how spread out the particles are, in inches.  Smaller means more certain.
+   */
+  double odom_wall_localization_spread_get();
+
   /**
    * Resets xyt to 0.
    */
@@ -1131,7 +1605,7 @@ class Drive {
    * \param check_if_pto
    *        motor to check
    */
-  bool pto_check(pros::Motor check_if_pto);
+  bool pto_check(const pros::Motor& check_if_pto);
 
   /**
    * Adds motors to the pto list, removing them from the drive.
@@ -1414,7 +1888,7 @@ class Drive {
    * \param speed
    *        0 to 127, max speed during motion
    */
-  void pid_odom_set(double target, int speed);
+  motion_handle pid_odom_set(double target, int speed);
 
   /**
    * Sets the robot to move forward using PID without okapi units, using slew if enabled for this motion.
@@ -1428,7 +1902,7 @@ class Drive {
    * \param slew_on
    *        ramp up from a lower speed to your target speed
    */
-  void pid_odom_set(double target, int speed, bool slew_on);
+  motion_handle pid_odom_set(double target, int speed, bool slew_on);
 
   /**
    * Sets the robot to move forward using PID with okapi units, only using slew if globally enabled.
@@ -1440,7 +1914,7 @@ class Drive {
    * \param speed
    *        0 to 127, max speed during motion
    */
-  void pid_odom_set(okapi::QLength p_target, int speed);
+  motion_handle pid_odom_set(okapi::QLength p_target, int speed);
 
   /**
    * Sets the robot to move forward using PID with okapi units, using slew if enabled for this motion.
@@ -1456,7 +1930,7 @@ class Drive {
    * \param toggle_heading
    *        toggle for heading correction.  true enables, false disables
    */
-  void pid_odom_set(okapi::QLength p_target, int speed, bool slew_on);
+  motion_handle pid_odom_set(okapi::QLength p_target, int speed, bool slew_on);
 
   /**
    * Takes in an odom movement to go to a single point.  If an angle is set, this will run boomerang.  Uses slew if globally enabled.
@@ -1464,7 +1938,7 @@ class Drive {
    * \param imovement
    *        {{x, y, t}, fwd/rev, 1-127}  an odom movement
    */
-  void pid_odom_set(odom imovement);
+  motion_handle pid_odom_set(odom imovement);
 
   /**
    * Takes in an odom movement to go to a single point.  If an angle is set, this will run boomerang.  Uses slew if enabled for this motion.
@@ -1474,7 +1948,7 @@ class Drive {
    * \param slew_on
    *        ramp up from a lower speed to your target speed
    */
-  void pid_odom_set(odom imovement, bool slew_on);
+  motion_handle pid_odom_set(odom imovement, bool slew_on);
 
   /**
    * Takes in an odom movement to go to a single point.  If an angle is set, this will run boomerang.  Uses slew if globally enabled.
@@ -1482,7 +1956,7 @@ class Drive {
    * \param imovement
    *        {{x, y, t}, fwd/rev, 1-127}  an odom movement
    */
-  void pid_odom_ptp_set(odom imovement);
+  motion_handle pid_odom_ptp_set(odom imovement);
 
   /**
    * Takes in an odom movement to go to a single point.  If an angle is set, this will run boomerang.  Uses slew if enabled for this motion.
@@ -1492,7 +1966,7 @@ class Drive {
    * \param slew_on
    *        ramp up from a lower speed to your target speed
    */
-  void pid_odom_ptp_set(odom imovement, bool slew_on);
+  motion_handle pid_odom_ptp_set(odom imovement, bool slew_on);
 
   /**
    * Takes in an odom movement to go to a single point using boomerang.  If an angle is set, this will run boomerang.  Uses slew if globally enabled.
@@ -1500,7 +1974,7 @@ class Drive {
    * \param imovement
    *        {{x, y, t}, fwd/rev, 1-127}  an odom movement
    */
-  void pid_odom_boomerang_set(odom imovement);
+  motion_handle pid_odom_boomerang_set(odom imovement);
 
   /**
    * Takes in an odom movement to go to a single point using boomerang.  If an angle is set, this will run boomerang.  Uses slew if enabled for this motion.
@@ -1510,7 +1984,7 @@ class Drive {
    * \param slew_on
    *        ramp up from a lower speed to your target speed
    */
-  void pid_odom_boomerang_set(odom imovement, bool slew_on);
+  motion_handle pid_odom_boomerang_set(odom imovement, bool slew_on);
 
   /**
    * Takes in an odom movement to go to a single point using boomerang.  If an angle is set, this will run boomerang.  Uses slew if globally enabled.
@@ -1518,7 +1992,7 @@ class Drive {
    * \param imovement
    *        {{x, y, t}, fwd/rev, 1-127}  an odom movement.  values are united here with okapi units
    */
-  void pid_odom_boomerang_set(united_odom p_imovement);
+  motion_handle pid_odom_boomerang_set(united_odom p_imovement);
 
   /**
    * Takes in an odom movement to go to a single point using boomerang.  If an angle is set, this will run boomerang.  Uses slew if enabled for this motion.
@@ -1528,7 +2002,7 @@ class Drive {
    * \param slew_on
    *        ramp up from a lower speed to your target speed
    */
-  void pid_odom_boomerang_set(united_odom p_imovement, bool slew_on);
+  motion_handle pid_odom_boomerang_set(united_odom p_imovement, bool slew_on);
 
   /**
    * Takes in an odom movement to go to a single point.  If an angle is set, this will run boomerang.  Uses slew if globally enabled.
@@ -1536,7 +2010,7 @@ class Drive {
    * \param imovement
    *        {{x, y, t}, fwd/rev, 1-127}  an odom movement.  values are united here with okapi units
    */
-  void pid_odom_ptp_set(united_odom p_imovement);
+  motion_handle pid_odom_ptp_set(united_odom p_imovement);
 
   /**
    * Takes in an odom movement to go to a single point.  If an angle is set, this will run boomerang.  Uses slew if enabled for this motion.
@@ -1546,7 +2020,7 @@ class Drive {
    * \param slew_on
    *        ramp up from a lower speed to your target speed
    */
-  void pid_odom_ptp_set(united_odom p_imovement, bool slew_on);
+  motion_handle pid_odom_ptp_set(united_odom p_imovement, bool slew_on);
 
   /**
    * Takes in an odom movement to go to a single point.  If an angle is set, this will run boomerang.  Uses slew if globally enabled.
@@ -1554,7 +2028,7 @@ class Drive {
    * \param imovement
    *        {{x, y, t}, fwd/rev, 1-127}  an odom movement.  values are united here with okapi units
    */
-  void pid_odom_set(united_odom p_imovement);
+  motion_handle pid_odom_set(united_odom p_imovement);
 
   /**
    * Takes in an odom movement to go to a single point.  If an angle is set, this will run boomerang.  Uses slew if enabled for this motion.
@@ -1564,7 +2038,7 @@ class Drive {
    * \param slew_on
    *        ramp up from a lower speed to your target speed
    */
-  void pid_odom_set(united_odom p_imovement, bool slew_on);
+  motion_handle pid_odom_set(united_odom p_imovement, bool slew_on);
 
   /**
    * Takes in odom movements to go through multiple points, will inject and smooth the path.  If an angle is set, this will run boomerang for that point.  Uses slew if globally enabled.
@@ -1572,7 +2046,7 @@ class Drive {
    * \param imovements
    *        {{{x, y, t}, fwd/rev, 1-127}, {{x, y, t}, fwd/rev, 1-127}}  odom movements
    */
-  void pid_odom_set(std::vector<odom> imovements);
+  motion_handle pid_odom_set(std::vector<odom> imovements);
 
   /**
    * Takes in odom movements to go through multiple points, will inject and smooth the path.  If an angle is set, this will run boomerang for that point.  Uses slew if enabled for this motion.
@@ -1582,7 +2056,7 @@ class Drive {
    * \param slew_on
    *        ramp up from a lower speed to your target speed
    */
-  void pid_odom_set(std::vector<odom> imovements, bool slew_on);
+  motion_handle pid_odom_set(std::vector<odom> imovements, bool slew_on);
 
   /**
    * Takes in odom movements to go through multiple points.  If an angle is set, this will run boomerang for that point.  Uses slew if globally enabled.
@@ -1590,7 +2064,7 @@ class Drive {
    * \param imovements
    *        {{{x, y, t}, fwd/rev, 1-127}, {{x, y, t}, fwd/rev, 1-127}}  odom movements
    */
-  void pid_odom_pp_set(std::vector<odom> imovements);
+  motion_handle pid_odom_pp_set(std::vector<odom> imovements);
 
   /**
    * Takes in odom movements to go through multiple points.  If an angle is set, this will run boomerang for that point.  Uses slew if enabled for this motion.
@@ -1600,7 +2074,7 @@ class Drive {
    * \param slew_on
    *        ramp up from a lower speed to your target speed
    */
-  void pid_odom_pp_set(std::vector<odom> imovements, bool slew_on);
+  motion_handle pid_odom_pp_set(std::vector<odom> imovements, bool slew_on);
 
   /**
    * Takes in odom movements to go through multiple points, will inject into the path.  If an angle is set, this will run boomerang for that point.  Uses slew if globally enabled.
@@ -1608,7 +2082,7 @@ class Drive {
    * \param imovements
    *        {{{x, y, t}, fwd/rev, 1-127}, {{x, y, t}, fwd/rev, 1-127}}  odom movements
    */
-  void pid_odom_injected_pp_set(std::vector<odom> imovements);
+  motion_handle pid_odom_injected_pp_set(std::vector<odom> imovements);
 
   /**
    * Takes in odom movements to go through multiple points, will inject into the path.  If an angle is set, this will run boomerang for that point.  Uses slew if enabled for this motion.
@@ -1618,7 +2092,7 @@ class Drive {
    * \param slew_on
    *        ramp up from a lower speed to your target speed
    */
-  void pid_odom_injected_pp_set(std::vector<odom> imovements, bool slew_on);
+  motion_handle pid_odom_injected_pp_set(std::vector<odom> imovements, bool slew_on);
 
   /**
    * Takes in odom movements to go through multiple points, will inject and smooth the path.  If an angle is set, this will run boomerang for that point.  Uses slew if globally enabled.
@@ -1626,7 +2100,7 @@ class Drive {
    * \param imovements
    *        {{{x, y, t}, fwd/rev, 1-127}, {{x, y, t}, fwd/rev, 1-127}}  odom movements
    */
-  void pid_odom_smooth_pp_set(std::vector<odom> imovements);
+  motion_handle pid_odom_smooth_pp_set(std::vector<odom> imovements);
 
   /**
    * Takes in odom movements to go through multiple points, will inject and smooth the path.  If an angle is set, this will run boomerang for that point.  Uses slew if enabled for this motion.
@@ -1636,7 +2110,7 @@ class Drive {
    * \param slew_on
    *        ramp up from a lower speed to your target speed
    */
-  void pid_odom_smooth_pp_set(std::vector<odom> imovements, bool slew_on);
+  motion_handle pid_odom_smooth_pp_set(std::vector<odom> imovements, bool slew_on);
 
   /**
    * Takes in odom movements to go through multiple points, will inject and smooth the path.  If an angle is set, this will run boomerang for that point.  Uses slew if globally enabled.
@@ -1644,7 +2118,7 @@ class Drive {
    * \param imovements
    *        {{{x, y, t}, fwd/rev, 1-127}, {{x, y, t}, fwd/rev, 1-127}}  odom movements.  values are united here with okapi units
    */
-  void pid_odom_smooth_pp_set(std::vector<united_odom> p_imovements);
+  motion_handle pid_odom_smooth_pp_set(std::vector<united_odom> p_imovements);
 
   /**
    * Takes in odom movements to go through multiple points, will inject and smooth the path.  If an angle is set, this will run boomerang for that point.  Uses slew if enabled for this motion.
@@ -1654,7 +2128,7 @@ class Drive {
    * \param slew_on
    *        ramp up from a lower speed to your target speed
    */
-  void pid_odom_smooth_pp_set(std::vector<united_odom> p_imovements, bool slew_on);
+  motion_handle pid_odom_smooth_pp_set(std::vector<united_odom> p_imovements, bool slew_on);
 
   /**
    * Takes in odom movements to go through multiple points, will inject into the path.  If an angle is set, this will run boomerang for that point.  Uses slew if globally enabled.
@@ -1662,7 +2136,7 @@ class Drive {
    * \param imovements
    *        {{{x, y, t}, fwd/rev, 1-127}, {{x, y, t}, fwd/rev, 1-127}}  odom movements.  values are united here with okapi units
    */
-  void pid_odom_injected_pp_set(std::vector<united_odom> p_imovements);
+  motion_handle pid_odom_injected_pp_set(std::vector<united_odom> p_imovements);
 
   /**
    * Takes in odom movements to go through multiple points, will inject into the path.  If an angle is set, this will run boomerang for that point.  Uses slew if enabled for this motion.
@@ -1672,7 +2146,7 @@ class Drive {
    * \param slew_on
    *        ramp up from a lower speed to your target speed
    */
-  void pid_odom_injected_pp_set(std::vector<united_odom> p_imovements, bool slew_on);
+  motion_handle pid_odom_injected_pp_set(std::vector<united_odom> p_imovements, bool slew_on);
 
   /**
    * Takes in odom movements to go through multiple points.  If an angle is set, this will run boomerang for that point.  Uses slew if globally enabled.
@@ -1680,7 +2154,7 @@ class Drive {
    * \param imovements
    *        {{{x, y, t}, fwd/rev, 1-127}, {{x, y, t}, fwd/rev, 1-127}}  odom movements.  values are united here with okapi units
    */
-  void pid_odom_pp_set(std::vector<united_odom> p_imovements);
+  motion_handle pid_odom_pp_set(std::vector<united_odom> p_imovements);
 
   /**
    * Takes in odom movements to go through multiple points.  If an angle is set, this will run boomerang for that point.  Uses slew if enabled for this motion.
@@ -1690,7 +2164,7 @@ class Drive {
    * \param slew_on
    *        ramp up from a lower speed to your target speed
    */
-  void pid_odom_pp_set(std::vector<united_odom> p_imovements, bool slew_on);
+  motion_handle pid_odom_pp_set(std::vector<united_odom> p_imovements, bool slew_on);
 
   /**
    * Takes in odom movements to go through multiple points, will inject and smooth the path.  If an angle is set, this will run boomerang for that point.  Uses slew if globally enabled.
@@ -1698,7 +2172,7 @@ class Drive {
    * \param imovements
    *        {{{x, y, t}, fwd/rev, 1-127}, {{x, y, t}, fwd/rev, 1-127}}  odom movements.  values are united here with okapi units
    */
-  void pid_odom_set(std::vector<united_odom> p_imovements);
+  motion_handle pid_odom_set(std::vector<united_odom> p_imovements);
 
   /**
    * Takes in odom movements to go through multiple points, will inject and smooth the path.  If an angle is set, this will run boomerang for that point.  Uses slew if enabled for this motion.
@@ -1708,7 +2182,7 @@ class Drive {
    * \param slew_on
    *        ramp up from a lower speed to your target speed
    */
-  void pid_odom_set(std::vector<united_odom> p_imovements, bool slew_on);
+  motion_handle pid_odom_set(std::vector<united_odom> p_imovements, bool slew_on);
 
   /**
    * Sets the robot to move forward using PID with okapi units, only using slew if globally enabled.
@@ -1718,7 +2192,7 @@ class Drive {
    * \param speed
    *        0 to 127, max speed during motion
    */
-  void pid_drive_set(okapi::QLength p_target, int speed);
+  motion_handle pid_drive_set(okapi::QLength p_target, int speed);
 
   /**
    * Sets the robot to move forward using PID with okapi units, using slew if enabled for this motion.
@@ -1732,7 +2206,7 @@ class Drive {
    * \param toggle_heading
    *        toggle for heading correction.  true enables, false disables
    */
-  void pid_drive_set(okapi::QLength p_target, int speed, bool slew_on, bool toggle_heading = true);
+  motion_handle pid_drive_set(okapi::QLength p_target, int speed, bool slew_on, bool toggle_heading = true);
 
   /**
    * Sets the robot to move forward using PID without okapi units, only using slew if globally enabled.
@@ -1742,7 +2216,7 @@ class Drive {
    * \param speed
    *        0 to 127, max speed during motion
    */
-  void pid_drive_set(double target, int speed);
+  motion_handle pid_drive_set(double target, int speed);
 
   /**
    * Sets the robot to move forward using PID without okapi units, using slew if enabled for this motion.
@@ -1756,7 +2230,7 @@ class Drive {
    * \param toggle_heading
    *        toggle for heading correction.  true enables, false disables
    */
-  void pid_drive_set(double target, int speed, bool slew_on, bool toggle_heading = true);
+  motion_handle pid_drive_set(double target, int speed, bool slew_on, bool toggle_heading = true);
 
   /**
    * Sets the robot to turn face a point using PID and odometry.
@@ -1766,7 +2240,7 @@ class Drive {
    * \param speed
    *        0 to 127, max speed during motion
    */
-  void pid_turn_set(pose itarget, drive_directions dir, int speed);
+  motion_handle pid_turn_set(pose itarget, drive_directions dir, int speed);
 
   /**
    * Sets the robot to turn face a point using PID and odometry.
@@ -1778,7 +2252,7 @@ class Drive {
    * \param slew_on
    *        ramp up from a lower speed to your target speed
    */
-  void pid_turn_set(pose itarget, drive_directions dir, int speed, bool slew_on);
+  motion_handle pid_turn_set(pose itarget, drive_directions dir, int speed, bool slew_on);
 
   /**
    * Sets the robot to turn face a point using PID and odometry.
@@ -1790,7 +2264,7 @@ class Drive {
    * \param behavior
    *        changes what direction the robot will turn.  can be left, right, shortest, longest, raw
    */
-  void pid_turn_set(pose itarget, drive_directions dir, int speed, e_angle_behavior behavior);
+  motion_handle pid_turn_set(pose itarget, drive_directions dir, int speed, e_angle_behavior behavior);
 
   /**
    * Sets the robot to turn face a point using PID and odometry.
@@ -1804,7 +2278,7 @@ class Drive {
    * \param slew_on
    *        ramp up from a lower speed to your target speed
    */
-  void pid_turn_set(pose itarget, drive_directions dir, int speed, e_angle_behavior behavior, bool slew_on);
+  motion_handle pid_turn_set(pose itarget, drive_directions dir, int speed, e_angle_behavior behavior, bool slew_on);
 
   /**
    * Sets the robot to turn face a point using PID and odometry.
@@ -1814,7 +2288,7 @@ class Drive {
    * \param speed
    *        0 to 127, max speed during motion
    */
-  void pid_turn_set(united_pose p_itarget, drive_directions dir, int speed);
+  motion_handle pid_turn_set(united_pose p_itarget, drive_directions dir, int speed);
 
   /**
    * Sets the robot to turn face a point using PID and odometry.
@@ -1826,7 +2300,7 @@ class Drive {
    * \param slew_on
    *        ramp up from a lower speed to your target speed
    */
-  void pid_turn_set(united_pose p_itarget, drive_directions dir, int speed, bool slew_on);
+  motion_handle pid_turn_set(united_pose p_itarget, drive_directions dir, int speed, bool slew_on);
 
   /**
    * Sets the robot to turn face a point using PID and odometry.
@@ -1838,7 +2312,7 @@ class Drive {
    * \param behavior
    *        changes what direction the robot will turn.  can be left, right, shortest, longest, raw
    */
-  void pid_turn_set(united_pose p_itarget, drive_directions dir, int speed, e_angle_behavior behavior);
+  motion_handle pid_turn_set(united_pose p_itarget, drive_directions dir, int speed, e_angle_behavior behavior);
 
   /**
    * Sets the robot to turn face a point using PID and odometry.
@@ -1852,7 +2326,7 @@ class Drive {
    * \param slew_on
    *        ramp up from a lower speed to your target speed
    */
-  void pid_turn_set(united_pose p_itarget, drive_directions dir, int speed, e_angle_behavior behavior, bool slew_on);
+  motion_handle pid_turn_set(united_pose p_itarget, drive_directions dir, int speed, e_angle_behavior behavior, bool slew_on);
 
   /**
    * Sets the robot to turn relative to initial heading using PID.
@@ -1864,7 +2338,7 @@ class Drive {
    * \param slew_on
    *        ramp up from a lower speed to your target speed
    */
-  void pid_turn_set(double target, int speed);
+  motion_handle pid_turn_set(double target, int speed);
 
   /**
    * Sets the robot to turn relative to initial heading using PID.
@@ -1876,7 +2350,7 @@ class Drive {
    * \param behavior
    *        changes what direction the robot will turn.  can be left, right, shortest, longest, raw
    */
-  void pid_turn_set(double target, int speed, e_angle_behavior behavior);
+  motion_handle pid_turn_set(double target, int speed, e_angle_behavior behavior);
 
   /**
    * Sets the robot to turn relative to initial heading using PID, using slew if enabled for this motion.
@@ -1888,7 +2362,7 @@ class Drive {
    * \param slew_on
    *        ramp up from a lower speed to your target speed
    */
-  void pid_turn_set(double target, int speed, bool slew_on);
+  motion_handle pid_turn_set(double target, int speed, bool slew_on);
 
   /**
    * Sets the robot to turn relative to initial heading using PID, using slew if enabled for this motion.
@@ -1902,7 +2376,7 @@ class Drive {
    * \param slew_on
    *        ramp up from a lower speed to your target speed
    */
-  void pid_turn_set(double target, int speed, e_angle_behavior behavior, bool slew_on);
+  motion_handle pid_turn_set(double target, int speed, e_angle_behavior behavior, bool slew_on);
 
   /**
    * Sets the robot to turn relative to initial heading using PID with okapi units.
@@ -1912,7 +2386,7 @@ class Drive {
    * \param speed
    *        0 to 127, max speed during motion
    */
-  void pid_turn_set(okapi::QAngle p_target, int speed);
+  motion_handle pid_turn_set(okapi::QAngle p_target, int speed);
 
   /**
    * Sets the robot to turn relative to initial heading using PID with okapi units.
@@ -1924,7 +2398,7 @@ class Drive {
    * \param behavior
    *        changes what direction the robot will turn.  can be left, right, shortest, longest, raw
    */
-  void pid_turn_set(okapi::QAngle p_target, int speed, e_angle_behavior behavior);
+  motion_handle pid_turn_set(okapi::QAngle p_target, int speed, e_angle_behavior behavior);
 
   /**
    * Sets the robot to turn relative to initial heading using PID with okapi units, using slew if enabled for this motion.
@@ -1936,7 +2410,7 @@ class Drive {
    * \param slew_on
    *        ramp up from a lower speed to your target speed
    */
-  void pid_turn_set(okapi::QAngle p_target, int speed, bool slew_on);
+  motion_handle pid_turn_set(okapi::QAngle p_target, int speed, bool slew_on);
 
   /**
    * Sets the robot to turn relative to initial heading using PID with okapi units, using slew if enabled for this motion.
@@ -1950,7 +2424,7 @@ class Drive {
    * \param slew_on
    *        ramp up from a lower speed to your target speed
    */
-  void pid_turn_set(okapi::QAngle p_target, int speed, e_angle_behavior behavior, bool slew_on);
+  motion_handle pid_turn_set(okapi::QAngle p_target, int speed, e_angle_behavior behavior, bool slew_on);
 
   /**
    * Sets the robot to turn relative to current heading using PID with okapi units, only using slew if globally enabled.
@@ -1960,7 +2434,7 @@ class Drive {
    * \param speed
    *        0 to 127, max speed during motion
    */
-  void pid_turn_relative_set(okapi::QAngle p_target, int speed);
+  motion_handle pid_turn_relative_set(okapi::QAngle p_target, int speed);
 
   /**
    * Sets the robot to turn relative to current heading using PID with okapi units, only using slew if globally enabled.
@@ -1972,7 +2446,7 @@ class Drive {
    * \param behavior
    *        changes what direction the robot will turn.  can be left, right, shortest, longest, raw
    */
-  void pid_turn_relative_set(okapi::QAngle p_target, int speed, e_angle_behavior behavior);
+  motion_handle pid_turn_relative_set(okapi::QAngle p_target, int speed, e_angle_behavior behavior);
 
   /**
    * Sets the robot to turn relative to current heading using PID with okapi units, using slew if enabled for this motion.
@@ -1984,7 +2458,7 @@ class Drive {
    * \param slew_on
    *        ramp up from a lower speed to your target speed
    */
-  void pid_turn_relative_set(okapi::QAngle p_target, int speed, bool slew_on);
+  motion_handle pid_turn_relative_set(okapi::QAngle p_target, int speed, bool slew_on);
 
   /**
    * Sets the robot to turn relative to current heading using PID with okapi units, using slew if enabled for this motion.
@@ -1998,7 +2472,7 @@ class Drive {
    * \param slew_on
    *        ramp up from a lower speed to your target speed
    */
-  void pid_turn_relative_set(okapi::QAngle p_target, int speed, e_angle_behavior behavior, bool slew_on);
+  motion_handle pid_turn_relative_set(okapi::QAngle p_target, int speed, e_angle_behavior behavior, bool slew_on);
 
   /**
    * Sets the robot to turn relative to current heading using PID without okapi units, only using slew if globally enabled.
@@ -2008,7 +2482,7 @@ class Drive {
    * \param speed
    *        0 to 127, max speed during motion
    */
-  void pid_turn_relative_set(double target, int speed);
+  motion_handle pid_turn_relative_set(double target, int speed);
 
   /**
    * Sets the robot to turn relative to current heading using PID without okapi units, only using slew if globally enabled.
@@ -2020,7 +2494,7 @@ class Drive {
    * \param behavior
    *        changes what direction the robot will turn.  can be left, right, shortest, longest, raw
    */
-  void pid_turn_relative_set(double target, int speed, e_angle_behavior behavior);
+  motion_handle pid_turn_relative_set(double target, int speed, e_angle_behavior behavior);
 
   /**
    * Sets the robot to turn relative to current heading using PID without okapi units, using slew if enabled for this motion.
@@ -2032,7 +2506,7 @@ class Drive {
    * \param slew_on
    *        ramp up from a lower speed to your target speed
    */
-  void pid_turn_relative_set(double target, int speed, bool slew_on);
+  motion_handle pid_turn_relative_set(double target, int speed, bool slew_on);
 
   /**
    * Sets the robot to turn relative to current heading using PID without okapi units, using slew if enabled for this motion.
@@ -2046,7 +2520,7 @@ class Drive {
    * \param slew_on
    *        ramp up from a lower speed to your target speed
    */
-  void pid_turn_relative_set(double target, int speed, e_angle_behavior behavior, bool slew_on);
+  motion_handle pid_turn_relative_set(double target, int speed, e_angle_behavior behavior, bool slew_on);
 
   /**
    * Sets the robot to turn using only the left or right side relative to initial heading without okapi units, only using slew if globally enabled.
@@ -2058,7 +2532,7 @@ class Drive {
    * \param speed
    *        0 to 127, max speed during motion
    */
-  void pid_swing_set(e_swing type, double target, int speed);
+  motion_handle pid_swing_set(e_swing type, double target, int speed);
 
   /**
    * Sets the robot to turn using only the left or right side relative to initial heading without okapi units, only using slew if globally enabled.
@@ -2072,7 +2546,7 @@ class Drive {
    * \param behavior
    *        changes what direction the robot will turn.  can be left, right, shortest, longest, raw
    */
-  void pid_swing_set(e_swing type, double target, int speed, e_angle_behavior behavior);
+  motion_handle pid_swing_set(e_swing type, double target, int speed, e_angle_behavior behavior);
 
   /**
    * Sets the robot to turn using only the left or right side relative to initial heading without okapi units, using slew if enabled for this motion.
@@ -2086,7 +2560,7 @@ class Drive {
    * \param slew_on
    *        ramp up from a lower speed to your target speed
    */
-  void pid_swing_set(e_swing type, double target, int speed, bool slew_on);
+  motion_handle pid_swing_set(e_swing type, double target, int speed, bool slew_on);
 
   /**
    * Sets the robot to turn using only the left or right side relative to initial heading without okapi units, using slew if enabled for this motion.
@@ -2100,7 +2574,7 @@ class Drive {
    * \param slew_on
    *        ramp up from a lower speed to your target speed
    */
-  void pid_swing_set(e_swing type, double target, int speed, e_angle_behavior behavior, bool slew_on);
+  motion_handle pid_swing_set(e_swing type, double target, int speed, e_angle_behavior behavior, bool slew_on);
 
   /**
    * Sets the robot to turn using only the left or right side relative to initial heading without okapi units, only using slew if globally enabled.
@@ -2114,7 +2588,7 @@ class Drive {
    * \param opposite_speed
    *        -127 to 127, max speed of the opposite side of the drive during the swing. this is used for arcs, and is defaulted to 0
    */
-  void pid_swing_set(e_swing type, double target, int speed, int opposite_speed);
+  motion_handle pid_swing_set(e_swing type, double target, int speed, int opposite_speed);
 
   /**
    * Sets the robot to turn using only the left or right side relative to initial heading without okapi units, only using slew if globally enabled.
@@ -2128,7 +2602,7 @@ class Drive {
    * \param opposite_speed
    *        -127 to 127, max speed of the opposite side of the drive during the swing. this is used for arcs, and is defaulted to 0
    */
-  void pid_swing_set(e_swing type, double target, int speed, int opposite_speed, e_angle_behavior behavior);
+  motion_handle pid_swing_set(e_swing type, double target, int speed, int opposite_speed, e_angle_behavior behavior);
 
   /**
    * Sets the robot to turn using only the left or right side relative to initial heading without okapi units, using slew if enabled for this motion.
@@ -2144,7 +2618,7 @@ class Drive {
    * \param slew_on
    *        ramp up from a lower speed to your target speed
    */
-  void pid_swing_set(e_swing type, double target, int speed, int opposite_speed, bool slew_on);
+  motion_handle pid_swing_set(e_swing type, double target, int speed, int opposite_speed, bool slew_on);
 
   /**
    * Sets the robot to turn using only the left or right side relative to initial heading without okapi units, using slew if enabled for this motion.
@@ -2162,7 +2636,7 @@ class Drive {
    * \param slew_on
    *        ramp up from a lower speed to your target speed
    */
-  void pid_swing_set(e_swing type, double target, int speed, int opposite_speed, e_angle_behavior behavior, bool slew_on);
+  motion_handle pid_swing_set(e_swing type, double target, int speed, int opposite_speed, e_angle_behavior behavior, bool slew_on);
 
   /**
    * Sets the robot to turn using only the left or right side relative to initial heading with okapi units, only using slew if globally enabled.
@@ -2174,7 +2648,7 @@ class Drive {
    * \param speed
    *        0 to 127, max speed during motion
    */
-  void pid_swing_set(e_swing type, okapi::QAngle p_target, int speed);
+  motion_handle pid_swing_set(e_swing type, okapi::QAngle p_target, int speed);
 
   /**
    * Sets the robot to turn using only the left or right side relative to initial heading with okapi units, only using slew if globally enabled.
@@ -2188,7 +2662,7 @@ class Drive {
    * \param behavior
    *        changes what direction the robot will turn.  can be left, right, shortest, longest, raw
    */
-  void pid_swing_set(e_swing type, okapi::QAngle p_target, int speed, e_angle_behavior behavior);
+  motion_handle pid_swing_set(e_swing type, okapi::QAngle p_target, int speed, e_angle_behavior behavior);
 
   /**
    * Sets the robot to turn using only the left or right side relative to initial heading with okapi units, using slew if enabled for this motion.
@@ -2202,7 +2676,7 @@ class Drive {
    * \param slew_on
    *        ramp up from a lower speed to your target speed
    */
-  void pid_swing_set(e_swing type, okapi::QAngle p_target, int speed, bool slew_on);
+  motion_handle pid_swing_set(e_swing type, okapi::QAngle p_target, int speed, bool slew_on);
 
   /**
    * Sets the robot to turn using only the left or right side relative to initial heading with okapi units, using slew if enabled for this motion.
@@ -2218,7 +2692,7 @@ class Drive {
    * \param slew_on
    *        ramp up from a lower speed to your target speed
    */
-  void pid_swing_set(e_swing type, okapi::QAngle p_target, int speed, e_angle_behavior behavior, bool slew_on);
+  motion_handle pid_swing_set(e_swing type, okapi::QAngle p_target, int speed, e_angle_behavior behavior, bool slew_on);
 
   /**
    * Sets the robot to turn using only the left or right side relative to initial heading with okapi units, only using slew if globally enabled.
@@ -2232,7 +2706,7 @@ class Drive {
    * \param opposite_speed
    *        -127 to 127, max speed of the opposite side of the drive during the swing. this is used for arcs, and is defaulted to 0
    */
-  void pid_swing_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed);
+  motion_handle pid_swing_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed);
 
   /**
    * Sets the robot to turn using only the left or right side relative to initial heading with okapi units, only using slew if globally enabled.
@@ -2248,7 +2722,7 @@ class Drive {
    * \param behavior
    *        changes what direction the robot will turn.  can be left, right, shortest, longest, raw
    */
-  void pid_swing_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed, e_angle_behavior behavior);
+  motion_handle pid_swing_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed, e_angle_behavior behavior);
 
   /**
    * Sets the robot to turn using only the left or right side relative to initial heading with okapi units, using slew if enabled for this motion.
@@ -2264,7 +2738,7 @@ class Drive {
    * \param slew_on
    *        ramp up from a lower speed to your target speed
    */
-  void pid_swing_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed, bool slew_on);
+  motion_handle pid_swing_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed, bool slew_on);
 
   /**
    * Sets the robot to turn only using the left or right side relative to initial heading using PID with okapi units, using slew if enabled for this motion.
@@ -2282,7 +2756,7 @@ class Drive {
    * \param slew_on
    *        ramp up from a lower speed to your target speed
    */
-  void pid_swing_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed, e_angle_behavior behavior, bool slew_on);
+  motion_handle pid_swing_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed, e_angle_behavior behavior, bool slew_on);
 
   /**
    * Sets the robot to turn only using the left or right side relative to current heading using PID with okapi units, only using slew if globally enabled.
@@ -2294,7 +2768,7 @@ class Drive {
    * \param speed
    *        0 to 127, max speed during motion
    */
-  void pid_swing_relative_set(e_swing type, okapi::QAngle p_target, int speed);
+  motion_handle pid_swing_relative_set(e_swing type, okapi::QAngle p_target, int speed);
 
   /**
    * Sets the robot to turn only using the left or right side relative to current heading using PID with okapi units, only using slew if globally enabled.
@@ -2306,7 +2780,7 @@ class Drive {
    * \param speed
    *        0 to 127, max speed during motion
    */
-  void pid_swing_relative_set(e_swing type, okapi::QAngle p_target, int speed, e_angle_behavior behavior);
+  motion_handle pid_swing_relative_set(e_swing type, okapi::QAngle p_target, int speed, e_angle_behavior behavior);
 
   /**
    * Sets the robot to turn only using the left or right side relative to current heading using PID with okapi units, using slew if enabled for this motion.
@@ -2318,7 +2792,7 @@ class Drive {
    * \param speed
    *        0 to 127, max speed during motion
    */
-  void pid_swing_relative_set(e_swing type, okapi::QAngle p_target, int speed, bool slew_on);
+  motion_handle pid_swing_relative_set(e_swing type, okapi::QAngle p_target, int speed, bool slew_on);
 
   /**
    * Sets the robot to turn only using the left or right side relative to current heading using PID with okapi units, using slew if enabled for this motion.
@@ -2330,7 +2804,7 @@ class Drive {
    * \param speed
    *        0 to 127, max speed during motion
    */
-  void pid_swing_relative_set(e_swing type, okapi::QAngle p_target, int speed, e_angle_behavior behavior, bool slew_on);
+  motion_handle pid_swing_relative_set(e_swing type, okapi::QAngle p_target, int speed, e_angle_behavior behavior, bool slew_on);
 
   /**
    * Sets the robot to turn only using the left or right side relative to current heading using PID with okapi units, only using slew if globally enabled.
@@ -2344,7 +2818,7 @@ class Drive {
    * \param opposite_speed
    *        -127 to 127, max speed of the opposite side of the drive during the swing. this is used for arcs, and is defaulted to 0
    */
-  void pid_swing_relative_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed);
+  motion_handle pid_swing_relative_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed);
 
   /**
    * Sets the robot to turn only using the left or right side relative to current heading using PID with okapi units, only using slew if globally enabled.
@@ -2358,7 +2832,7 @@ class Drive {
    * \param opposite_speed
    *        -127 to 127, max speed of the opposite side of the drive during the swing. this is used for arcs, and is defaulted to 0
    */
-  void pid_swing_relative_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed, e_angle_behavior behavior);
+  motion_handle pid_swing_relative_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed, e_angle_behavior behavior);
 
   /**
    * Sets the robot to turn only using the left or right side relative to current heading using PID with okapi units, using slew if enabled for this motion.
@@ -2372,7 +2846,7 @@ class Drive {
    * \param opposite_speed
    *        -127 to 127, max speed of the opposite side of the drive during the swing. this is used for arcs, and is defaulted to 0
    */
-  void pid_swing_relative_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed, bool slew_on);
+  motion_handle pid_swing_relative_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed, bool slew_on);
 
   /**
    * Sets the robot to turn only using the left or right side relative to current heading using PID with okapi units, using slew if enabled for this motion.
@@ -2386,7 +2860,7 @@ class Drive {
    * \param opposite_speed
    *        -127 to 127, max speed of the opposite side of the drive during the swing. this is used for arcs, and is defaulted to 0
    */
-  void pid_swing_relative_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed, e_angle_behavior behavior, bool slew_on);
+  motion_handle pid_swing_relative_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed, e_angle_behavior behavior, bool slew_on);
 
   /**
    * Sets the robot to turn only using the left or right side relative to current heading using PID without okapi units, only using slew if globally enabled.
@@ -2398,7 +2872,7 @@ class Drive {
    * \param speed
    *        0 to 127, max speed during motion
    */
-  void pid_swing_relative_set(e_swing type, double target, int speed);
+  motion_handle pid_swing_relative_set(e_swing type, double target, int speed);
 
   /**
    * Sets the robot to turn only using the left or right side relative to current heading using PID without okapi units, only using slew if globally enabled.
@@ -2410,7 +2884,7 @@ class Drive {
    * \param speed
    *        0 to 127, max speed during motion
    */
-  void pid_swing_relative_set(e_swing type, double target, int speed, e_angle_behavior behavior);
+  motion_handle pid_swing_relative_set(e_swing type, double target, int speed, e_angle_behavior behavior);
 
   /**
    * Sets the robot to turn only using the left or right side relative to current heading using PID without okapi units, using slew if enabled for this motion.
@@ -2422,7 +2896,7 @@ class Drive {
    * \param speed
    *        0 to 127, max speed during motion
    */
-  void pid_swing_relative_set(e_swing type, double target, int speed, bool slew_on);
+  motion_handle pid_swing_relative_set(e_swing type, double target, int speed, bool slew_on);
 
   /**
    * Sets the robot to turn only using the left or right side relative to current heading using PID without okapi units, using slew if enabled for this motion.
@@ -2434,7 +2908,7 @@ class Drive {
    * \param speed
    *        0 to 127, max speed during motion
    */
-  void pid_swing_relative_set(e_swing type, double target, int speed, e_angle_behavior behavior, bool slew_on);
+  motion_handle pid_swing_relative_set(e_swing type, double target, int speed, e_angle_behavior behavior, bool slew_on);
 
   /**
    * Sets the robot to turn only using the left or right side relative to current heading using PID without okapi units, only using slew if globally enabled.
@@ -2448,7 +2922,7 @@ class Drive {
    * \param opposite_speed
    *        -127 to 127, max speed of the opposite side of the drive during the swing. this is used for arcs, and is defaulted to 0
    */
-  void pid_swing_relative_set(e_swing type, double target, int speed, int opposite_speed);
+  motion_handle pid_swing_relative_set(e_swing type, double target, int speed, int opposite_speed);
 
   /**
    * Sets the robot to turn only using the left or right side relative to current heading using PID without okapi units, only using slew if globally enabled.
@@ -2462,7 +2936,7 @@ class Drive {
    * \param opposite_speed
    *        -127 to 127, max speed of the opposite side of the drive during the swing. this is used for arcs, and is defaulted to 0
    */
-  void pid_swing_relative_set(e_swing type, double target, int speed, int opposite_speed, e_angle_behavior behavior);
+  motion_handle pid_swing_relative_set(e_swing type, double target, int speed, int opposite_speed, e_angle_behavior behavior);
 
   /**
    * Sets the robot to turn only using the left or right side relative to current heading using PID without okapi units, using slew if enabled for this motion.
@@ -2476,7 +2950,7 @@ class Drive {
    * \param opposite_speed
    *        -127 to 127, max speed of the opposite side of the drive during the swing. this is used for arcs, and is defaulted to 0
    */
-  void pid_swing_relative_set(e_swing type, double target, int speed, int opposite_speed, bool slew_on);
+  motion_handle pid_swing_relative_set(e_swing type, double target, int speed, int opposite_speed, bool slew_on);
 
   /**
    * Sets the robot to turn only using the left or right side relative to current heading using PID without okapi units, using slew if enabled for this motion.
@@ -2490,7 +2964,7 @@ class Drive {
    * \param opposite_speed
    *        -127 to 127, max speed of the opposite side of the drive during the swing. this is used for arcs, and is defaulted to 0
    */
-  void pid_swing_relative_set(e_swing type, double target, int speed, int opposite_speed, e_angle_behavior behavior, bool slew_on);
+  motion_handle pid_swing_relative_set(e_swing type, double target, int speed, int opposite_speed, e_angle_behavior behavior, bool slew_on);
 
   /**
    * Resets all PID targets to 0.
@@ -2552,6 +3026,37 @@ class Drive {
    */
   void pid_wait_quick_chain();
 
+  /**
+   * Runs a list of motions back to back inside of the autonomous task.
+   *
+   * Each function should start one motion, like [&]() { chassis.pid_drive_set(24_in, 110); }.
+   * Every motion except the last one is chained like pid_wait_quick_chain(), and the next motion starts
+   * in the same tick the last one passes its target.  The last motion exits normally.
+   *
+   * This returns right away.  Starting any other motion, or calling this again, clears the queue.
+   * The functions run inside of the autonomous task, so they can't call pid_wait() or any other wait, that would
+   * stop the task that's running the motion.  Waits called from there print an error and return right away.
+   *
+   * \param motions
+   *        functions that each start one motion
+   */
+  void motion_queue(std::vector<std::function<void()>> motions);
+
+  /**
+   * Lock the code in a while loop until every motion in the queue has run and the last one has settled.
+   */
+  void motion_queue_wait();
+
+  /**
+   * Removes every motion from the queue that hasn't started yet.  The current motion keeps running.
+   */
+  void motion_queue_clear();
+
+  /**
+   * Returns how many motions in the queue haven't started yet.
+   */
+  int motion_queue_size_get();
+
   /**
    * Lock the code in a while loop until this point has been passed.
    *
@@ -2669,6 +3174,36 @@ class Drive {
    */
   PID::Constants pid_turn_constants_get();
 
+  /**
+   * Sets feedforward constants for turn motions.  This does nothing until pid_turn_profile_set() is also used.
+   *
+   * With feedforward, PID only has to correct the error that's left, so lower P constants work.
+   *
+   * \param ks
+   *        output to overcome static friction
+   * \param kv
+   *        output per degrees per second
+   * \param ka
+   *        output per degrees per second per second
+   */
+  void pid_turn_feedforward_set(double ks, double kv = 0.0, double ka = 0.0);
+
+  /**
+   * Returns feedforward constants for turn motions.
+   */
+  PID::Feedforward pid_turn_feedforward_get();
+
+  /**
+   * Sets the motion profile that feedforward follows during turn motions.  Setting either to 0 disables the profile.
+   * PID corrects the error to where the profile is, and exits still use the real target.
+   *
+   * \param max_velocity
+   *        fastest the profile moves, in degrees per second
+   * \param max_acceleration
+   *        fastest the profile speeds up and slows down, in degrees per second per second
+   */
+  void pid_turn_profile_set(double max_velocity, double max_acceleration);
+
   /**
    * Sets the amount that the PID will overshoot target by to maintain momentum into the next motion.
    *
@@ -2863,6 +3398,36 @@ class Drive {
    */
   PID::Constants pid_drive_constants_get();
 
+  /**
+   * Sets feedforward constants for drive motions.  This does nothing until pid_drive_profile_set() is also used.
+   *
+   * With feedforward, PID only has to correct the error that's left, so lower P constants work.
+   *
+   * \param ks
+   *        output to overcome static friction
+   * \param kv
+   *        output per inches per second
+   * \param ka
+   *        output per inches per second per second
+   */
+  void pid_drive_feedforward_set(double ks, double kv = 0.0, double ka = 0.0);
+
+  /**
+   * Returns feedforward constants for drive motions.
+   */
+  PID::Feedforward pid_drive_feedforward_get();
+
+  /**
+   * Sets the motion profile that feedforward follows during drive motions.  Setting either to 0 disables the profile.
+   * PID corrects the error to where the profile is, and exits still use the real target.
+   *
+   * \param max_velocity
+   *        fastest the profile moves, in inches per second
+   * \param max_acceleration
+   *        fastest the profile speeds up and slows down, in inches per second per second
+   */
+  void pid_drive_profile_set(double max_velocity, double max_acceleration);
+
   /**
    * Set the forward pid constants object.
    *
@@ -3259,9 +3824,42 @@ class Drive {
 
   /**
    * Iterates through controller inputs to modify PID constants.
+   *
+   * X starts autotuning the selected constants and B stops it.
    */
   void pid_tuner_iterate();
 
+  /**
+   * Starts autotuning the constants selected in the PID Tuner.
+   *
+   * The robot is driven back and forth around where it is now, and the constants are replaced once this finishes.
+   * Moving a joystick stops autotuning.  start_i isn't changed.
+   *
+   * \param relay_output
+   *        output used in each direction, 0 to 127
+   * \param hysteresis
+   *        error has to pass this before changing direction, in inches for drive and degrees for everything else
+   */
+  void pid_tuner_autotune_start(double relay_output = 60.0, double hysteresis = 0.5);
+
+  /**
+   * Stops autotuning without changing constants.
+   */
+  void pid_tuner_autotune_stop();
+
+  /**
+   * Returns true while autotuning.
+   */
+  bool pid_tuner_autotune_running();
+
+  /**
+   * Sets the rule autotuning uses to make constants.
+   *
+   * \param rule
+   *        AUTOTUNE_CLASSIC, AUTOTUNE_SOME_OVERSHOOT or AUTOTUNE_NO_OVERSHOOT
+   */
+  void pid_tuner_autotune_rule_set(e_autotune_rule rule);
+
   /**
    * Toggle for printing the display of the PID Tuner to the brain.
    *
@@ -3358,31 +3956,32 @@ class Drive {
   struct const_and_name {
     std::string name = "";
     PID::Constants* consts;
+    e_mode mode = DISABLE;  // How autotuning moves the robot for these constants, DISABLE can't be autotuned
   };
 
   /**
    * Vector used for a simplified PID Tuner
    */
   std::vector<const_and_name> pid_tuner_pids = {
-      {"Drive PID Constants", &fwd_rev_drivePID.constants},
-      {"Odom Angular PID Constants", &odom_angularPID.constants},
-      {"Boomerang Angular PID Constants", &boomerangPID.constants},
-      {"Heading PID Constants", &headingPID.constants},
-      {"Turn PID Constants", &turnPID.constants},
-      {"Swing PID Constants", &fwd_rev_swingPID.constants}};
+      {"Drive PID Constants", &fwd_rev_drivePID.constants, DRIVE},
+      {"Odom Angular PID Constants", &odom_angularPID.constants, TURN},
+      {"Boomerang Angular PID Constants", &boomerangPID.constants, TURN},
+      {"Heading PID Constants", &headingPID.constants, TURN},
+      {"Turn PID Constants", &turnPID.constants, TURN},
+      {"Swing PID Constants", &fwd_rev_swingPID.constants, SWING}};
 
   /**
    * Vector used for the full PID Tuner
    */
   std::vector<const_and_name> pid_tuner_full_pids = {
-      {"Drive Forward PID Constants", &forward_drivePID.constants},
-      {"Drive Backward PID Constants", &backward_drivePID.constants},
-      {"Odom Angular PID Constants", &odom_angularPID.constants},
-      {"Boomerang Angular PID Constants", &boomerangPID.constants},
-      {"Heading PID Constants", &headingPID.constants},
-      {"Turn PID Constants", &turnPID.constants},
-      {"Swing Forward PID Constants", &forward_swingPID.constants},
-      {"Swing Backward PID Constants", &backward_swingPID.constants}};
+      {"Drive Forward PID Constants", &forward_drivePID.constants, DRIVE},
+      {"Drive Backward PID Constants", &backward_drivePID.constants, DRIVE},
+      {"Odom Angular PID Constants", &odom_angularPID.constants, TURN},
+      {"Boomerang Angular PID Constants", &boomerangPID.constants, TURN},
+      {"Heading PID Constants", &headingPID.constants, TURN},
+      {"Turn PID Constants", &turnPID.constants, TURN},
+      {"Swing Forward PID Constants", &forward_swingPID.constants, SWING},
+      {"Swing Backward PID Constants", &backward_swingPID.constants, SWING}};
 
   /**
    * Sets the max speed for user control.
@@ -3471,18 +4070,47 @@ class Drive {
   double max_boomerang_distance = 12.0;
   double odom_turn_bias_amount = 1.375;
   drive_directions current_drive_direction = fwd;
-  double h_last = 0.0, t_last = 0.0, l_last = 0.0, r_last = 0.0;
-  pose l_pose{0.0, 0.0, 0.0};
-  pose r_pose{0.0, 0.0, 0.0};
-  pose central_pose{0.0, 0.0, 0.0};
+  odom_tracker odom_tracking;
+  odom_tracker_config tracker_config_build(odom_tracker_input* input = nullptr);
+  e_odom_integrator odom_integrator = ODOM_ARC;
+  seqlock<pose> odom_integrator_published[3];
+  least_squares_weights least_squares_weight;
+  struct least_squares_extra {
+    tracking_wheel* tracker = nullptr;
+    odom_least_squares_sensor sensor;
+  };
+  least_squares_extra least_squares_extras[ODOM_LEAST_SQUARES_MAX];
+  int least_squares_extra_count = 0;
+  e_odom_heading odom_heading = ODOM_HEADING_IMU;
+  int fusion_time_constant = 2000;
+  double fusion_gate = 5.0;
+
+  /**
+   * Odometry recording, only written while holding odom_mutex.  odom_recording_mutex keeps start() from
+   * reallocating it while it's being saved, so the file is written without holding odom_mutex.
+   */
+  odom_recording odom_recorder;
+  pros::Mutex odom_recording_mutex;
+  void odom_recording_event(e_odom_frame type, double value = 0.0);
+
+  /**
+   * Pose history.  Only the odometry task and the setters write (both hold odom_mutex), anything can read.
+   * odom_history_count is how many poses have ever been added, the newest is at (count - 1) % ODOM_HISTORY_SIZE.
+   */
+  struct timed_pose {
+    std::uint64_t time = 0;
+    pose odom = {0.0, 0.0, 0.0};
+  };
+  seqlock<timed_pose> odom_history[ODOM_HISTORY_SIZE];
+  std::atomic<int> odom_history_count{0};
+  void odom_history_add(std::uint64_t time, pose input);
+  pose odom_pose_predict_at(std::uint64_t time);
+  int odom_latency = 0;
   double xy_current_fake = 0.0;
   double xy_last_fake = 0.0;
   double xy_delta_fake = 0.0;
   double new_current_fake = 0.0;
   bool was_odom_just_set = false;
-  std::pair<float, float> decide_vert_sensor(ez::tracking_wheel* tracker, bool is_tracker_enabled, float ime = 0.0, float ime_track = 0.0);
-  pose solve_xy_vert(float p_track_width, float current_t, float delta_vert, float delta_t);
-  pose solve_xy_horiz(float p_track_width, float current_t, float delta_horiz, float delta_t);
   bool was_last_pp_mode_boomerang = false;
   bool global_forward_drive_slew_enabled = false;
   bool global_backward_drive_slew_enabled = false;
@@ -3541,6 +4169,11 @@ class Drive {
   bool pid_tuner_on = false;
   std::string complete_pid_tuner_output = "";
   float p_increment = 0.1, i_increment = 0.001, d_increment = 0.25, start_i_increment = 1.0;
+  relay_autotuner autotuner;
+  e_mode autotune_mode = DISABLE;
+  int autotune_column = 0;
+  double autotune_sensor();
+  void autotune_iterate();
 
   /**
    * Private wait until for drive
@@ -3584,6 +4217,13 @@ class Drive {
    */
   int max_speed;
 
+  /**
+   * Feedforward profiles, the start time is pros::micros() when the motion started.
+   */
+  std::uint64_t drive_profile_start = 0;
+  std::uint64_t turn_profile_start = 0;
+  void profile_follow(trapezoid_profile* profile, std::uint64_t start, double start_position, PID* pid);
+
   /**
    * Tasks
    */
@@ -3592,9 +4232,157 @@ class Drive {
   void turn_pid_task();
   void ez_auto_task();
   void ptp_task();
+  void task_timing_iterate(task_timing* timing, std::uint64_t* last_tick, std::uint64_t now);
+  void task_deadline_wait(task_timing* timing, std::uint32_t* next_wake);
   void boomerang_task();
   void pp_task();
 
+  /**
+   * Autonomous task timing
+   */
+  int drive_task_period = util::DELAY_TIME;
+  task_timing drive_timing;
+  std::uint64_t drive_timing_last_tick = 0;
+  stage_timer drive_stage_timers[STAGE_COUNT];
+
+  /**
+   * Odometry task
+   */
+  int odom_task_period = 5;
+  task_timing odom_timing;
+  std::uint64_t odom_timing_last_tick = 0;
+  void ez_odom_task();
+  void odom_task_timing_reset();
+
+  /**
+   * Wall localization task.  The filter only runs in this task, odom_mutex is only held to apply a correction.
+   * wall_mutex keeps sensors and the field from changing during an update.
+   */
+  wall_localizer localizer;
+  pros::Distance* wall_sensors[wall_localizer::MAX_SENSORS] = {};
+  pros::Mutex wall_mutex;
+  std::atomic<bool> wall_enabled{false};
+  std::atomic<bool> wall_reset{true};
+  double wall_blend = 0.2;
+  double wall_spread_max = 3.0;
+  int wall_latency = 33;
+  struct wall_estimate {
+    pose odom = {0.0, 0.0, 0.0};
+    double spread = 0.0;
+  };
+  seqlock<wall_estimate> wall_published;
+  void ez_localize_task();
+  void odom_correction_apply(double dx, double dy);
+
+  /**
+   * The odometry task is the only thing that writes to odom_current while it's running, everything else reads
+   * the pose through odom_published.  odom_mutex is only used to keep the setters from running during a tracking update.
+   * Sensors are read before odom_mutex is taken, odom_sensor_resets goes up whenever sensors or the IMU are reset
+   * so a tick that read them before a reset is skipped.
+   */
+  seqlock<pose> odom_published;
+  pros::Mutex odom_mutex;
+  std::atomic<int> odom_sensor_resets{0};
+  void xy_fake_iterate();
+
+  /**
+   * Every device is read once per tick into a frame and every stage reads from that frame.
+   * The autonomous task and the odometry task each have their own.
+   */
+  sensor_frame drive_frame;
+  sensor_frame odom_frame;
+  seqlock<sensor_frame> drive_frame_published;
+  void sensor_frame_sample(sensor_frame* output, bool all_sensors = true);
+
+  /**
+   * Exit conditions are checked in the autonomous task every tick, and each one latches on the first exit it hits.
+   * exit_epoch goes up whenever a motion starts or a wait_until reaches its target, and that clears the latches and PID timers.
+   * Every task waiting on a motion gets notified after every tick, up to EXIT_WAITERS_MAX at once.
+   */
+  struct exit_state {
+    int epoch = 0;
+    exit_output left = RUNNING;
+    exit_output right = RUNNING;
+    exit_output xy = RUNNING;
+    exit_output angular = RUNNING;
+    exit_output turn = RUNNING;
+    exit_output swing = RUNNING;
+  };
+  std::atomic<int> exit_epoch{0};
+  exit_state exits;
+  seqlock<exit_state> exits_published;
+  static const int EXIT_WAITERS_MAX = 4;
+  std::atomic<pros::task_t> exit_waiters[EXIT_WAITERS_MAX] = {};
+  void exits_iterate(e_mode current_mode);
+  void exits_rearm();
+  bool exits_wait(int epoch, exit_state* output);
+  bool wait_in_auto_task();
+  static bool drive_target_passed(int l_sgn, int r_sgn, double l_error, double r_error);
+
+  /**
+   * Every call to drive_mode_set() starts a new motion with a new id.  The last few motions are
+   * remembered so handles can find out how their motion ended.
+   */
+  friend class motion_handle;
+  struct motion_record {
+    int id = 0;
+    e_mode mode = DISABLE;
+    exit_output exit = RUNNING;
+  };
+  static const int MOTION_HISTORY = 16;
+  motion_record motion_history[MOTION_HISTORY];
+  std::atomic<int> motion_id{0};
+  std::function<void()> motion_callback;
+  int motion_callback_id = 0;
+  pros::Mutex motion_mutex;
+  void motion_start(e_mode p_mode);
+  void motion_iterate(e_mode current_mode, int current_motion);
+  exit_output motion_exit_compute(e_mode current_mode);
+  exit_output motion_exit_get(int id);
+  motion_handle motion_current();
+
+  /**
+   * Motion queue.  The chain is where the current queued motion hands off to the next one,
+   * it's set up by the autonomous task right after a queued motion starts.
+   */
+  struct motion_chain {
+    bool active = false;
+    bool extended = false;
+    e_mode mode = DISABLE;
+    double left = 0.0;
+    double right = 0.0;
+    double angle = 0.0;
+    pose point = {0.0, 0.0, 0.0};
+    int sgn_left = 0;
+    int sgn_right = 0;
+    int sgn = 0;
+    bool point_started = false;
+  };
+  std::vector<std::function<void()>> motion_queue_list;
+  std::size_t motion_queue_index = 0;
+  motion_chain queue_chain;
+  pros::Mutex motion_queue_mutex;
+  bool motion_queue_iterate(e_mode current_mode);
+  bool motion_chain_extend();
+  void motion_chain_start();
+  bool motion_chain_passed(e_mode current_mode);
+  int drive_stages_print_period = 0;
+  std::uint32_t drive_stages_last_print = 0;
+
+  /**
+   * Motors that get power from the drive.  This is rebuilt when the pto list changes,
+   * so setting the drive doesn't search the pto list for every motor.
+   *
+   * pto_ports has bit (port - 1) set for every port in the pto list.
+   */
+  static const int MAX_DRIVE_MOTORS = 21;
+  std::uint32_t pto_ports = 0;
+  pros::Motor* left_output[MAX_DRIVE_MOTORS] = {};
+  pros::Motor* right_output[MAX_DRIVE_MOTORS] = {};
+  int left_output_count = 0;
+  int right_output_count = 0;
+  void drive_output_update();
+
   /**
    * Starting value for left/right
    */
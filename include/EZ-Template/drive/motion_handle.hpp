@@ -0,0 +1,129 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla Public
+License, v. 2.0. If a copy of the MPL was not distributed with this
+file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include <functional>
+
+#include "EZ-Template/util.hpp"
+#include "okapi/api/units/QAngle.hpp"
+#include "okapi/api/units/QLength.hpp"
+
+namespace ez {
+class Drive;
+
+/**
+ * Returned from every pid_*_set function, this refers to the motion that was just started.
+ *
+ * Handles are small and can be copied freely.  Once another motion starts, the handle's motion
+ * is finished and waiting on it returns right away.
+ */
+class motion_handle {
+ public:
+  /**
+   * Creates a handle that doesn't refer to a motion.  Everything returns right away.
+   */
+  motion_handle() = default;
+
+  /**
+   * Creates a handle for a motion.
+   *
+   * \param drive
+   *        the drive running the motion
+   * \param id
+   *        id of the motion
+   */
+  motion_handle(Drive* drive, int id);
+
+  /**
+   * Waits until this motion has settled.  This is the same as pid_wait().
+   */
+  void wait();
+
+  /**
+   * Waits until this motion passes a target.  This is the same as pid_wait_until().
+   *
+   * \param target
+   *        for driving, using inches.  for turning, using degrees.
+   */
+  void wait_until(double target);
+
+  /**
+   * Waits until this drive motion passes a distance.
+   *
+   * \param target
+   *        distance, okapi unit
+   */
+  void wait_until(okapi::QLength target);
+
+  /**
+   * Waits until this turn or swing passes an angle.
+   *
+   * \param target
+   *        angle, okapi unit
+   */
+  void wait_until(okapi::QAngle target);
+
+  /**
+   * Waits until this odom motion passes a point.
+   *
+   * \param target
+   *        {x, y} a pose for the robot to pass through before the function ends
+   */
+  void wait_until(pose target);
+
+  /**
+   * Waits until this odom motion passes a point.
+   *
+   * \param target
+   *        {x, y} a pose with units for the robot to pass through before the function ends
+   */
+  void wait_until(united_pose target);
+
+  /**
+   * Stops this motion if it's still running and turns the drive off.
+   */
+  void cancel();
+
+  /**
+   * Returns true once this motion has exited, was cancelled, or another motion started.
+   */
+  bool done();
+
+  /**
+   * Returns how this motion ended.
+   *
+   * RUNNING while it's still going, and INTERRUPTED_EXIT if it was cancelled or another motion started.
+   */
+  exit_output exit_get();
+
+  /**
+   * Sets a function to run when this motion exits.
+   *
+   * This runs inside of the autonomous task, so it should be short and must not wait.
+   * If the motion already exited, this runs right away in the calling task.  It does not run if the
+   * motion is cancelled or another motion starts first.
+   *
+   * \param callback
+   *        function to run
+   */
+  void complete_callback_set(std::function<void()> callback);
+
+  /**
+   * Returns the id of this motion.
+   */
+  int id_get();
+
+ private:
+  /**
+   * Returns true if this is the motion the drive is running.
+   */
+  bool current();
+
+  Drive* drive = nullptr;
+  int id = 0;
+};
+}  // namespace ez
@@ -0,0 +1,79 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla Public
+License, v. 2.0. If a copy of the MPL was not distributed with this
+file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include <cmath>
+
+/**
+ * Math odometry uses when building EZ-Template.
+ *
+ * 0 uses float with the normal sin/cos, this is the default.
+ * 1 uses double with the normal sin/cos.
+ * 2 uses float with fast_sin/fast_cos.
+ *
+ * This only changes odom_tracker.cpp, so it doesn't matter what this is set to in your own code.
+ */
+#ifndef EZ_TEMPLATE_ODOM_PRECISION
+#define EZ_TEMPLATE_ODOM_PRECISION 0
+#endif
+
+namespace ez {
+namespace util {
+/**
+ * Taylor series for sin to x^9.  The largest error is at pi/2.
+ *
+ * \param x
+ *        angle in radians, between -pi/2 and pi/2
+ */
+inline float fast_sin_reduced(float x) {
+  float x2 = x * x;
+  return x * (1.0f + x2 * (-1.0f / 6.0f + x2 * (1.0f / 120.0f + x2 * (-1.0f / 5040.0f + x2 * (1.0f / 362880.0f)))));
+}
+
+/**
+ * Fast sin using a polynomial instead of the math library.
+ *
+ * Error is under 4e-6 within one rotation, and under 6e-6 within 16 rotations (100 radians)
+ * where float range reduction starts to lose precision.
+ *
+ * \param x
+ *        angle in radians
+ */
+inline float fast_sin(float x) {
+  const float two_pi = 6.28318530718f;
+  const float pi = 3.14159265359f;
+  const float half_pi = 1.57079632679f;
+
+  // Bring x into -pi/2 to pi/2, where sin is symmetric
+  x -= two_pi * std::nearbyint(x * (1.0f / two_pi));
+  if (x > half_pi)
+    x = pi - x;
+  else if (x < -half_pi)
+    x = -pi - x;
+
+  return fast_sin_reduced(x);
+}
+
+/**
+ * Fast cos using a polynomial instead of the math library.
+ *
+ * Error is under 4e-6 within one rotation, and under 6e-6 within 16 rotations (100 radians).
+ * x isn't shifted by pi/2 before range reduction, that would round away precision on large angles.
+ *
+ * \param x
+ *        angle in radians
+ */
+inline float fast_cos(float x) {
+  const float two_pi = 6.28318530718f;
+  const float half_pi = 1.57079632679f;
+
+  // Bring x into -pi to pi, then cos(x) = sin(pi/2 - |x|)
+  x -= two_pi * std::nearbyint(x * (1.0f / two_pi));
+  return fast_sin_reduced(half_pi - std::fabs(x));
+}
+}  // namespace util
+}  // namespace ez
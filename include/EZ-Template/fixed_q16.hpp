@@ -0,0 +1,88 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla Public
+License, v. 2.0. If a copy of the MPL was not distributed with this
+file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+
+namespace ez {
+/**
+ * Q16.16 fixed point number.
+ *
+ * 16 bits are used for the whole number and 16 bits for the fraction, so this can hold
+ * -32768 to 32767 in steps of 1/65536.  Math is done with integers, and multiply / divide use
+ * a 64 bit intermediate so they don't overflow.
+ */
+class fixed_q16 {
+ public:
+  /**
+   * Scale of the raw value, 1.0 is stored as 65536.
+   */
+  static constexpr std::int32_t ONE = 1 << 16;
+
+  constexpr fixed_q16() = default;
+
+  /**
+   * Creates a fixed point number from a normal number.
+   *
+   * \param input
+   *        any int, float or double
+   */
+  template <typename T, std::enable_if_t<std::is_arithmetic_v<T>, int> = 0>
+  fixed_q16(T input) : raw(static_cast<std::int32_t>(std::lround(static_cast<double>(input) * ONE))) {}
+
+  /**
+   * Creates a fixed point number from its raw value.
+   *
+   * \param input
+   *        raw value, where 65536 is 1.0
+   */
+  static constexpr fixed_q16 from_raw(std::int32_t input) {
+    fixed_q16 output;
+    output.raw = input;
+    return output;
+  }
+
+  /**
+   * Returns the raw value, where 65536 is 1.0.
+   */
+  constexpr std::int32_t raw_get() const { return raw; }
+
+  explicit operator double() const { return static_cast<double>(raw) / ONE; }
+  explicit operator float() const { return static_cast<float>(raw) / ONE; }
+
+  friend constexpr fixed_q16 operator+(fixed_q16 a, fixed_q16 b) { return from_raw(a.raw + b.raw); }
+  friend constexpr fixed_q16 operator-(fixed_q16 a, fixed_q16 b) { return from_raw(a.raw - b.raw); }
+  friend constexpr fixed_q16 operator-(fixed_q16 a) { return from_raw(-a.raw); }
+  friend constexpr fixed_q16 operator*(fixed_q16 a, fixed_q16 b) {
+    return from_raw(static_cast<std::int32_t>((static_cast<std::int64_t>(a.raw) * b.raw) >> 16));
+  }
+  friend constexpr fixed_q16 operator/(fixed_q16 a, fixed_q16 b) {
+    if (b.raw == 0) return from_raw(0);
+    return from_raw(static_cast<std::int32_t>((static_cast<std::int64_t>(a.raw) << 16) / b.raw));
+  }
+
+  constexpr fixed_q16& operator+=(fixed_q16 b) { return *this = *this + b; }
+  constexpr fixed_q16& operator-=(fixed_q16 b) { return *this = *this - b; }
+  constexpr fixed_q16& operator*=(fixed_q16 b) { return *this = *this * b; }
+  constexpr fixed_q16& operator/=(fixed_q16 b) { return *this = *this / b; }
+
+  friend constexpr bool operator==(fixed_q16 a, fixed_q16 b) { return a.raw == b.raw; }
+  friend constexpr bool operator!=(fixed_q16 a, fixed_q16 b) { return a.raw != b.raw; }
+  friend constexpr bool operator<(fixed_q16 a, fixed_q16 b) { return a.raw < b.raw; }
+  friend constexpr bool operator>(fixed_q16 a, fixed_q16 b) { return a.raw > b.raw; }
+  friend constexpr bool operator<=(fixed_q16 a, fixed_q16 b) { return a.raw <= b.raw; }
+  friend constexpr bool operator>=(fixed_q16 a, fixed_q16 b) { return a.raw >= b.raw; }
+
+  friend constexpr fixed_q16 abs(fixed_q16 a) { return a.raw < 0 ? -a : a; }
+  friend constexpr fixed_q16 fabs(fixed_q16 a) { return abs(a); }
+
+ private:
+  std::int32_t raw = 0;
+};
+}  // namespace ez
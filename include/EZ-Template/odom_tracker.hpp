@@ -0,0 +1,469 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla Public
+License, v. 2.0. If a copy of the MPL was not distributed with this
+file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "EZ-Template/pose.hpp"
+
+// This doesn't use PROS, so recordings can be replayed through the same math on a computer
+
+namespace ez {
+/**
+ * Max amount of sensors least squares odometry can use.
+ */
+const int ODOM_LEAST_SQUARES_MAX = 16;
+
+/**
+ * Where a sensor is for least squares odometry.  Offsets are from the center of the robot, with x to the right
+ * and y forwards, in inches.
+ */
+struct odom_least_squares_sensor {
+  double x = 0.0;
+  double y = 0.0;
+  double angle = 0.0;   // direction the sensor reads positive, degrees clockwise from forwards
+  double weight = 1.0;  // how much this sensor is trusted, 0 ignores it
+
+  // Worked out once by odom_least_squares_sensor_make() so odometry doesn't redo trig every tick, math standard
+  double u_x = 1.0;     // direction the sensor reads positive
+  double u_y = 0.0;     //
+  double moment = 0.0;  // how much the sensor reads when the robot turns 1 radian
+
+  bool operator==(const odom_least_squares_sensor&) const = default;
+};
+
+/**
+ * Returns a least squares sensor with its direction and moment worked out.
+ *
+ * \param x
+ *        inches to the right of the center of the robot
+ * \param y
+ *        inches in front of the center of the robot
+ * \param angle
+ *        direction the sensor reads positive, degrees clockwise from forwards
+ * \param weight
+ *        how much this sensor is trusted, 0 ignores it
+ */
+odom_least_squares_sensor odom_least_squares_sensor_make(double x, double y, double angle, double weight = 1.0);
+
+/**
+ * Returns a least squares sensor pointing the same way as direction, but somewhere else.  This skips the trig.
+ *
+ * \param direction
+ *        sensor from odom_least_squares_sensor_make() to copy the direction of
+ * \param x
+ *        inches to the right of the center of the robot
+ * \param y
+ *        inches in front of the center of the robot
+ * \param weight
+ *        how much this sensor is trusted, 0 ignores it
+ */
+odom_least_squares_sensor odom_least_squares_sensor_move(const odom_least_squares_sensor& direction, double x, double y, double weight);
+
+/**
+ * Sensors odometry reads on one tick.  Distances are in inches and angles are in degrees.
+ */
+struct odom_tracker_input {
+  std::uint64_t time = 0;  // microseconds
+  double left = 0.0;       // left side of the drive
+  double right = 0.0;      // right side of the drive
+  double tracker_left = 0.0;
+  double tracker_right = 0.0;
+  double tracker_front = 0.0;
+  double tracker_back = 0.0;
+  double imu = 0.0;
+  double least_squares[ODOM_LEAST_SQUARES_MAX] = {};  // one for each least squares sensor
+};
+
+/**
+ * How the robot is set up for odometry.
+ */
+struct odom_tracker_config {
+  bool tracker_left = false;  // true when the tracking wheel is used
+  bool tracker_right = false;
+  bool tracker_front = false;
+  bool tracker_back = false;
+  double tracker_left_width = 0.0;  // distance_to_center_get() of each tracking wheel
+  double tracker_right_width = 0.0;
+  double tracker_front_width = 0.0;
+  double tracker_back_width = 0.0;
+  double ime_width_left = 0.0;  // used for the drive's sides when there isn't a tracking wheel
+  double ime_width_right = 0.0;
+  bool drive_integrated = true;  // true when the drive's sides are integrated encoders
+  bool use_left = true;          // side used when both or neither sides have a tracking wheel
+  int integrator = 0;            // e_odom_integrator, 0 uses arcs, 1 uses the exponential map and 2 uses least squares
+  bool fused_heading = false;    // true fuses the IMU with the wheels, false uses the IMU
+  double fusion_time_constant = 2.0;  // seconds for the learned IMU drift to get most of the way there
+  double fusion_gate_rate = 0.1;      // radians per second, drift is only learned below this turn rate and disagreement
+  odom_least_squares_sensor least_squares[ODOM_LEAST_SQUARES_MAX];
+  int least_squares_count = 0;
+  double least_squares_imu_weight = 100.0;
+
+  bool operator==(const odom_tracker_config&) const = default;
+};
+
+/**
+ * Everything odometry remembers between ticks.
+ */
+struct odom_tracker_state {
+  double h_last = 0.0, t_last = 0.0, l_last = 0.0, r_last = 0.0;
+  pose l_pose{0.0, 0.0, 0.0};
+  pose r_pose{0.0, 0.0, 0.0};
+  pose central_pose{0.0, 0.0, 0.0};
+  pose exp_poses[3] = {{0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}};  // left, right and central from the exponential map
+  double fused_t = 0.0, fused_last = 0.0;                                   // radians, math standard
+  double imu_bias = 0.0;                                                    // radians per second the IMU drifts, math standard
+  bool fusion_reset = true;
+  std::uint64_t fusion_time = 0;  // microseconds, time of the last tick
+  double least_squares_last[ODOM_LEAST_SQUARES_MAX] = {};
+  int least_squares_count = 0;  // sensors the lasts are for
+  pose least_squares_pose{0.0, 0.0, 0.0};
+};
+
+/**
+ * Turns sensor readings into a pose.  This is the math Drive's odometry task runs every tick.
+ */
+class odom_tracker {
+ public:
+  /**
+   * Sets how the robot is set up.
+   *
+   * \param input
+   *        new config
+   */
+  void config_set(const odom_tracker_config& input) { config = input; }
+
+  /**
+   * Returns how the robot is set up.
+   */
+  const odom_tracker_config& config_get() const { return config; }
+
+  /**
+   * Sets everything remembered between ticks.
+   *
+   * \param input
+   *        new state
+   */
+  void state_set(const odom_tracker_state& input) { state = input; }
+
+  /**
+   * Returns everything remembered between ticks.
+   */
+  const odom_tracker_state& state_get() const { return state; }
+
+  /**
+   * Runs one tick and returns the new pose.
+   *
+   * \param input
+   *        sensors for this tick
+   */
+  pose iterate(const odom_tracker_input& input);
+
+  /**
+   * Returns the pose from arcs on the last tick.
+   */
+  pose arc_get() const { return arc; }
+
+  /**
+   * Returns the pose from the exponential map on the last tick.
+   */
+  pose exp_get() const { return exp; }
+
+  /**
+   * Returns the pose from least squares on the last tick.
+   */
+  pose least_squares_get() const { return least_squares; }
+
+  /**
+   * Sets the x coordinate of every pose.
+   *
+   * \param x
+   *        new x, in inches
+   */
+  void x_set(double x);
+
+  /**
+   * Sets the y coordinate of every pose.
+   *
+   * \param y
+   *        new y, in inches
+   */
+  void y_set(double y);
+
+  /**
+   * Moves every pose, used when something outside of odometry corrects it.
+   *
+   * \param dx
+   *        change in x, in inches
+   * \param dy
+   *        change in y, in inches
+   */
+  void shift(double dx, double dy);
+
+  /**
+   * Sets the last angle, used when the IMU is reset.
+   *
+   * \param t
+   *        new last angle in radians
+   */
+  void t_last_set(double t) { state.t_last = t; }
+
+  /**
+   * Makes every last sensor value 0, used when sensors are reset.
+   */
+  void lasts_reset();
+
+  /**
+   * Restarts the fused heading from the IMU on the next tick.
+   */
+  void fusion_reset() { state.fusion_reset = true; }
+
+  /**
+   * Moves by a twist (forward, sideways, delta_t) in the robot's frame using the SE(2) exponential map.
+   * Returns the change in x and y.  This computes its own trig, the tracking task shares one set per tick.
+   *
+   * \param start_t
+   *        angle at the start, radians math standard
+   * \param delta_t
+   *        change in angle, radians math standard
+   * \param forward
+   *        distance forward in the robot's frame
+   * \param sideways
+   *        distance sideways in the robot's frame
+   */
+  static pose exp_map_step(double start_t, double delta_t, double forward, double sideways);
+
+ private:
+  /**
+   * Trig every tracker shares on a tick, so it's only computed once.
+   */
+  struct tracking_trig {
+    double delta_t = 0.0;       // change in angle this tick
+    double two_sin_half = 0.0;  // 2 * sin(delta_t / 2)
+    double sin_alpha = 0.0;     // sin of the angle halfway through the tick
+    double cos_alpha = 1.0;     // cos of the angle halfway through the tick
+  };
+  static tracking_trig tracking_trig_compute(double current_t, double delta_t);
+  static pose solve_xy_vert(const tracking_trig& trig, double p_track_width, double delta_vert);
+  static pose solve_xy_horiz(const tracking_trig& trig, double p_track_width, double delta_horiz);
+  static pose exp_map_apply(const tracking_trig& trig, double forward, double sideways);
+  void least_squares_twist(const odom_tracker_input& input, double delta_t, double* output);
+  static bool solve_3x3(double m[3][3], double b[3], double* output);
+
+  odom_tracker_config config;
+  odom_tracker_state state;
+  pose arc{0.0, 0.0, 0.0};
+  pose exp{0.0, 0.0, 0.0};
+  pose least_squares{0.0, 0.0, 0.0};
+};
+
+/**
+ * Moves newest forward by ahead, keeping the speed and turn rate the robot had going from past to newest.
+ *
+ * \param past
+ *        older pose
+ * \param newest
+ *        newest pose
+ * \param span
+ *        seconds from past to newest
+ * \param ahead
+ *        seconds to move newest forward by
+ */
+pose odom_pose_extrapolate(const pose& past, const pose& newest, double span, double ahead);
+
+/**
+ * Enum for what a recorded frame is.
+ */
+enum e_odom_frame { ODOM_FRAME_TICK = 0,          // odom_tracker::iterate() with input, output is the pose the robot got
+                    ODOM_FRAME_X_SET = 1,         // odom_tracker::x_set() with value
+                    ODOM_FRAME_Y_SET = 2,         // odom_tracker::y_set() with value
+                    ODOM_FRAME_T_LAST_SET = 3,    // odom_tracker::t_last_set() with value
+                    ODOM_FRAME_LASTS_RESET = 4,   // odom_tracker::lasts_reset()
+                    ODOM_FRAME_FUSION_RESET = 5,  // odom_tracker::fusion_reset()
+                    ODOM_FRAME_X_SHIFT = 6,       // odom_tracker::shift() in x with value
+                    ODOM_FRAME_Y_SHIFT = 7,       // odom_tracker::shift() in y with value
+                    ODOM_FRAME_CONFIG = 8 };      // odom_tracker::config_set() with the recorded config at index value
+
+/**
+ * One recorded frame.
+ */
+struct odom_recording_frame {
+  std::uint32_t type = ODOM_FRAME_TICK;
+  odom_tracker_input input;
+  pose output{0.0, 0.0, 0.0};
+  double value = 0.0;
+};
+
+/**
+ * Max amount of config changes a recording can hold.
+ */
+const int ODOM_RECORDING_CONFIG_MAX = 32;
+
+/**
+ * Start of a saved recording, followed by count odom_recording_frames in the order they happened,
+ * then config_count odom_tracker_configs that ODOM_FRAME_CONFIG frames point to.
+ */
+struct odom_recording_header {
+  char magic[4] = {'E', 'Z', 'O', 'R'};
+  std::uint32_t version = 6;
+  std::uint32_t frame_size = sizeof(odom_recording_frame);
+  std::uint32_t count = 0;
+  std::uint32_t config_size = sizeof(odom_tracker_config);
+  std::uint32_t config_count = 0;
+  odom_tracker_config config;  // config when recording started
+  odom_tracker_state state;    // state when recording started
+};
+
+/**
+ * Records everything that goes into odometry so it can be replayed.
+ *
+ * Memory is only allocated in start(), so recording never allocates or formats anything.
+ * Once full, or once the config has changed ODOM_RECORDING_CONFIG_MAX times, recording stops
+ * so the start of the recording is never lost.
+ */
+class odom_recording {
+ public:
+  /**
+   * Starts a new recording.
+   *
+   * \param frames
+   *        max amount of frames, 0 stops recording and frees memory
+   * \param config
+   *        config odometry is using right now
+   * \param state
+   *        state odometry has right now
+   */
+  void start(int frames, const odom_tracker_config& config, const odom_tracker_state& state);
+
+  /**
+   * Stops recording.  Recorded frames are kept.
+   */
+  void stop() { running = false; }
+
+  /**
+   * Returns true while frames are being recorded.
+   */
+  bool enabled() const { return running; }
+
+  /**
+   * Records a frame.  Recording stops once it's full.
+   *
+   * \param frame
+   *        frame to record
+   */
+  void record(const odom_recording_frame& frame) {
+    if (!running) return;
+    buffer[count++] = frame;
+    if (count >= buffer.size()) running = false;
+  }
+
+  /**
+   * Records the config used for the next tick, only when it's changed since the last one.
+   *
+   * \param time
+   *        time of the change, in microseconds
+   * \param config
+   *        config odometry is about to use
+   */
+  void config_record(std::uint64_t time, const odom_tracker_config& config);
+
+  /**
+   * Returns how many frames are recorded.
+   */
+  int size() const { return count; }
+
+  /**
+   * Returns how many config changes are recorded.
+   */
+  int config_size() const { return config_count; }
+
+  /**
+   * Saves the recording to a binary file.  Returns false if the file couldn't be written.
+   *
+   * \param path
+   *        file to write to
+   */
+  bool save(const char* path) const { return save(path, count, config_count); }
+
+  /**
+   * Saves the first frames and configs to a binary file.  Returns false if the file couldn't be written.
+   *
+   * Frames and configs are only ever added after the end, so this can run while recording continues
+   * as long as start() isn't called.
+   *
+   * \param path
+   *        file to write to
+   * \param frames
+   *        amount of frames to save, from size()
+   * \param configs
+   *        amount of configs to save, from config_size()
+   */
+  bool save(const char* path, std::size_t frames, std::size_t configs) const;
+
+ private:
+  std::vector<odom_recording_frame> buffer;
+  std::size_t count = 0;
+  std::vector<odom_tracker_config> configs;
+  std::size_t config_count = 0;
+  odom_tracker_config last_config;
+  bool running = false;
+  odom_recording_header header;
+};
+
+/**
+ * Reads a file saved with odom_recording::save().  Returns false if the file couldn't be read.
+ *
+ * \param path
+ *        file to read
+ * \param header
+ *        header from the file
+ * \param frames
+ *        frames from the file, in the order they happened
+ * \param configs
+ *        configs from the file, ODOM_FRAME_CONFIG frames point into this
+ */
+bool odom_recording_read(const char* path, odom_recording_header* header, std::vector<odom_recording_frame>* frames, std::vector<odom_tracker_config>* configs);
+
+/**
+ * Results of a replay.
+ */
+struct odom_replay_result {
+  std::vector<pose> trace;        // replayed pose for every tick
+  double max_error = 0.0;         // biggest xy distance between the replayed and recorded pose, in inches
+  double max_theta_error = 0.0;   // biggest angle between the replayed and recorded pose, in degrees
+  std::uint64_t total_time = 0;   // time spent in odom_tracker::iterate(), in clock units
+  std::uint64_t max_time = 0;     // longest odom_tracker::iterate(), in clock units
+};
+
+/**
+ * Runs a recording back through odom_tracker as fast as possible.
+ *
+ * \param header
+ *        header from odom_recording_read()
+ * \param frames
+ *        frames from odom_recording_read()
+ * \param configs
+ *        configs from odom_recording_read()
+ * \param clock
+ *        returns the time in any unit, used for timing each tick.  nullptr skips timing
+ */
+odom_replay_result odom_replay(const odom_recording_header& header, const std::vector<odom_recording_frame>& frames, const std::vector<odom_tracker_config>& configs, std::uint64_t (*clock)() = nullptr);
+
+/**
+ * Writes a replayed trace as CSV next to the recorded poses, with time in seconds.
+ *
+ * \param frames
+ *        frames from odom_recording_read()
+ * \param result
+ *        result from odom_replay() on the same frames
+ * \param file
+ *        file to write to, like stdout
+ */
+void odom_replay_csv_write(const std::vector<odom_recording_frame>& frames, const odom_replay_result& result, std::FILE* file);
+}  // namespace ez
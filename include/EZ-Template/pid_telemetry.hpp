@@ -0,0 +1,150 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla Public
+License, v. 2.0. If a copy of the MPL was not distributed with this
+file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+// This doesn't use PROS, so saved files can be read on a computer
+
+namespace ez {
+/**
+ * One PID compute.
+ */
+struct pid_sample {
+  std::uint64_t time = 0;  // microseconds
+  float target = 0;
+  float current = 0;
+  float error = 0;
+  float p = 0;  // output from p
+  float i = 0;  // output from i
+  float d = 0;  // output from d
+  float output = 0;
+  std::uint16_t small_exit_timer = 0;  // exit timers in ms, from the last exit check
+  std::uint16_t big_exit_timer = 0;
+  std::uint16_t velocity_exit_timer = 0;
+  std::uint16_t mA_exit_timer = 0;
+};
+
+/**
+ * Start of a saved telemetry file, followed by count pid_samples from oldest to newest.
+ */
+struct pid_telemetry_header {
+  char magic[4] = {'E', 'Z', 'P', 'T'};
+  std::uint32_t version = 1;
+  std::uint32_t sample_size = sizeof(pid_sample);
+  std::uint32_t count = 0;
+};
+
+/**
+ * Keeps the last samples of a PID.
+ *
+ * Memory is only allocated in resize(), so recording never allocates or formats anything.
+ * Once full, the oldest sample is overwritten.
+ *
+ * One task records while another can snapshot() or save().  Recording stops while samples are copied,
+ * so nothing torn gets saved, and samples computed during the copy aren't kept.
+ */
+class pid_telemetry {
+ public:
+  pid_telemetry() = default;
+  pid_telemetry(const pid_telemetry& other);
+  pid_telemetry& operator=(const pid_telemetry& other);
+
+  /**
+   * Sets how many samples are kept.  This clears everything recorded.
+   *
+   * \param samples
+   *        amount of samples, 0 disables recording and frees memory
+   */
+  void resize(int samples);
+
+  /**
+   * Returns true if samples are being kept.
+   */
+  bool enabled() const { return !buffer.empty(); }
+
+  /**
+   * Records a sample, overwriting the oldest one once full.
+   *
+   * \param sample
+   *        sample to record
+   */
+  void record(const pid_sample& sample) {
+    // writing lets snapshot() know if it stopped this halfway through
+    writing = true;
+    if (!paused) {
+      std::size_t at = head;
+      buffer[at] = sample;
+      head = at + 1 >= buffer.size() ? 0 : at + 1;
+      if (count < buffer.size()) count++;
+    }
+    writing = false;
+  }
+
+  /**
+   * Returns how many samples are recorded.
+   */
+  int size() const;
+
+  /**
+   * Returns a sample, 0 is the oldest.  Use snapshot() instead while the PID is computing.
+   *
+   * \param index
+   *        index of the sample
+   */
+  pid_sample get(int index) const;
+
+  /**
+   * Returns a copy of every recorded sample, oldest first.  This is safe to call while samples are being recorded.
+   */
+  std::vector<pid_sample> snapshot() const;
+
+  /**
+   * Removes every recorded sample.
+   */
+  void clear();
+
+  /**
+   * Saves every recorded sample to a binary file, oldest first.  Returns false if the file couldn't be written.
+   * Samples are copied with snapshot() first, so this is safe to call while samples are being recorded.
+   *
+   * \param path
+   *        file to write to
+   */
+  bool save(const char* path) const;
+
+ private:
+  std::vector<pid_sample> buffer;
+  std::atomic<std::size_t> head{0};
+  std::atomic<std::size_t> count{0};
+  mutable std::atomic<bool> paused{false};
+  std::atomic<bool> writing{false};
+};
+
+/**
+ * Reads a file saved with pid_telemetry::save().  Returns false if the file couldn't be read.
+ *
+ * \param path
+ *        file to read
+ * \param output
+ *        samples from the file, oldest first
+ */
+bool pid_telemetry_read(const char* path, std::vector<pid_sample>* output);
+
+/**
+ * Writes samples as CSV, with time in seconds.
+ *
+ * \param samples
+ *        samples to write
+ * \param file
+ *        file to write to, like stdout
+ */
+void pid_telemetry_csv_write(const std::vector<pid_sample>& samples, std::FILE* file);
+}  // namespace ez
@@ -0,0 +1,22 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla Public
+License, v. 2.0. If a copy of the MPL was not distributed with this
+file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+// This doesn't use PROS, so poses can be used on a computer
+
+namespace ez {
+const double ANGLE_NOT_SET = 0.0000000000000000000001;
+
+/**
+ * Struct for coordinates.
+ */
+typedef struct pose {
+  double x;
+  double y;
+  double theta = ANGLE_NOT_SET;
+} pose;
+}  // namespace ez
@@ -0,0 +1,106 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla Public
+License, v. 2.0. If a copy of the MPL was not distributed with this
+file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "api.h"
+
+/**
+ * Set this to 1 when building EZ-Template to time each stage of the chassis task.
+ *
+ * When this is 0 the timing code is compiled out and all stats stay at 0.
+ */
+#ifndef EZ_TEMPLATE_PROFILING
+#define EZ_TEMPLATE_PROFILING 0
+#endif
+
+namespace ez {
+
+/**
+ * Enum for stages of the chassis task that get timed.
+ */
+enum e_stage { STAGE_TICK = 0,
+               STAGE_TRACKING = 1,
+               STAGE_DRIVE_PID = 2,
+               STAGE_TURN_PID = 3,
+               STAGE_SWING_PID = 4,
+               STAGE_PTP = 5,
+               STAGE_PP = 6,
+               STAGE_DRIVE_SET = 7,
+               STAGE_COUNT = 8 };
+
+/**
+ * Outputs string for e_stage enum.
+ */
+std::string stage_to_string(e_stage input);
+
+class stage_timer {
+ public:
+  /**
+   * Amount of histogram buckets.
+   *
+   * Bucket n holds samples from 2^n to 2^(n+1) microseconds, and the last bucket holds everything larger.
+   */
+  static const int BUCKETS = 16;
+
+  /**
+   * Struct for timing stats, all times are in microseconds.
+   */
+  struct stats {
+    int count = 0;
+    std::uint32_t min = 0;
+    std::uint32_t max = 0;
+    double mean = 0.0;
+    int histogram[BUCKETS] = {};
+  };
+
+  /**
+   * Adds a sample.
+   *
+   * \param us
+   *        how long the stage took in microseconds
+   */
+  void add(std::uint32_t us);
+
+  /**
+   * Resets all stats to 0.
+   */
+  void reset();
+
+  /**
+   * Returns the current stats.
+   */
+  stats get();
+
+ private:
+  stats current;
+};
+
+/**
+ * Times the scope it's created in and adds it to a stage_timer when it ends.
+ */
+class stage_scope {
+ public:
+  stage_scope(stage_timer* timer) : timer(timer), start(pros::micros()) {}
+  ~stage_scope() { timer->add(pros::micros() - start); }
+
+ private:
+  stage_timer* timer;
+  std::uint64_t start;
+};
+}  // namespace ez
+
+#define EZ_PROFILE_CONCAT_(a, b) a##b
+#define EZ_PROFILE_CONCAT(a, b) EZ_PROFILE_CONCAT_(a, b)
+
+#if EZ_TEMPLATE_PROFILING
+#define EZ_PROFILE(timer) ez::stage_scope EZ_PROFILE_CONCAT(ez_profile_scope_, __LINE__)(&(timer))
+#else
+#define EZ_PROFILE(timer)
+#endif
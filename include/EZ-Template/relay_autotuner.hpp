@@ -0,0 +1,140 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla Public
+License, v. 2.0. If a copy of the MPL was not distributed with this
+file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include <cstdint>
+
+// This doesn't use PROS, so it can be run against a simulated mechanism on a computer
+
+namespace ez {
+/**
+ * Enum for the state of a relay autotuner.
+ */
+enum e_autotune_state { AUTOTUNE_IDLE = 0,
+                        AUTOTUNE_RUNNING = 1,
+                        AUTOTUNE_DONE = 2,
+                        AUTOTUNE_FAILED = 3 };
+
+/**
+ * Enum for the rules used to turn ultimate gain and period into PID constants.
+ */
+enum e_autotune_rule { AUTOTUNE_CLASSIC = 0,
+                       AUTOTUNE_SOME_OVERSHOOT = 1,
+                       AUTOTUNE_NO_OVERSHOOT = 2 };
+
+/**
+ * Finds PID constants with a relay (Astrom-Hagglund) experiment.
+ *
+ * The mechanism is driven full forward or full backward depending on which side of the target it's on,
+ * which makes it oscillate.  The size and period of that oscillation give the ultimate gain and period,
+ * and PID constants are made from those.
+ */
+class relay_autotuner {
+ public:
+  /**
+   * Struct for the result of an experiment.
+   */
+  struct Result {
+    double ultimate_gain = 0;    // Ku
+    double ultimate_period = 0;  // Tu, in seconds
+    double amplitude = 0;        // half of peak to peak oscillation, in sensor units
+    double kp = 0;
+    double ki = 0;
+    double kd = 0;
+  };
+
+  relay_autotuner();
+
+  /**
+   * Starts an experiment.
+   *
+   * \param target
+   *        sensor value to oscillate around
+   * \param relay_output
+   *        output used in each direction, the same units as PID output
+   * \param hysteresis
+   *        error has to pass this before the relay flips, this stops sensor noise from flipping it early
+   * \param cycles
+   *        oscillations to measure, the first one is always ignored
+   */
+  void initialize(double target, double relay_output, double hysteresis = 0.0, int cycles = 4);
+
+  /**
+   * Runs one loop of the experiment and returns the output to send to the mechanism.
+   *
+   * \param current
+   *        current sensor value
+   * \param time_us
+   *        time this sensor value was read, in microseconds
+   */
+  double iterate(double current, std::uint64_t time_us);
+
+  /**
+   * Stops the experiment.
+   */
+  void stop();
+
+  /**
+   * Sets how long the experiment can run before failing.
+   *
+   * \param time
+   *        time in ms, 0 disables the timeout
+   */
+  void timeout_set(int time);
+
+  /**
+   * Sets the rule used to make PID constants.
+   *
+   * \param rule
+   *        AUTOTUNE_CLASSIC, AUTOTUNE_SOME_OVERSHOOT or AUTOTUNE_NO_OVERSHOOT
+   */
+  void rule_set(e_autotune_rule rule);
+
+  /**
+   * Sets the loop time the PID will run at.  EZ-Template's i and d are per loop, so this is needed for ki and kd.
+   *
+   * \param time
+   *        time in ms
+   */
+  void loop_time_set(double time);
+
+  /**
+   * Returns the state of the experiment.
+   */
+  e_autotune_state state_get();
+
+  /**
+   * Returns the result of the experiment.  This is only filled in once the state is AUTOTUNE_DONE.
+   */
+  Result result_get();
+
+ private:
+  static const int MAX_CYCLES = 16;
+  void result_compute();
+
+  e_autotune_state state = AUTOTUNE_IDLE;
+  e_autotune_rule tuning_rule = AUTOTUNE_CLASSIC;
+  double loop_time = 10.0;
+  int timeout = 0;
+
+  double target = 0;
+  double relay = 0;
+  double hysteresis = 0;
+  int cycles_wanted = 0;
+  double output = 0;
+
+  std::uint64_t start_time = 0;
+  std::uint64_t last_rise = 0;
+  int rises = 0;
+  double peak_high = 0;
+  double peak_low = 0;
+  int cycles = 0;
+  double periods[MAX_CYCLES] = {};
+  double amplitudes[MAX_CYCLES] = {};
+  Result result;
+};
+}  // namespace ez
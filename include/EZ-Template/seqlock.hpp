@@ -0,0 +1,58 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla Public
+License, v. 2.0. If a copy of the MPL was not distributed with this
+file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace ez {
+/**
+ * Publishes a value from one task to many others without locking.
+ *
+ * Readers never block the writer.  If a read overlaps a write, the reader tries again,
+ * so a reader always gets a value that was fully written.
+ *
+ * Only one task can write at a time.  If multiple tasks write, they need to be serialized
+ * with something else (like a mutex).
+ */
+template <typename T>
+class seqlock {
+ public:
+  /**
+   * Publishes a new value.
+   *
+   * \param input
+   *        the new value
+   */
+  void write(const T& input) {
+    std::uint32_t seq = sequence.load(std::memory_order_relaxed);
+    sequence.store(seq + 1, std::memory_order_relaxed);  // Odd means a write is happening
+    std::atomic_thread_fence(std::memory_order_release);
+    data = input;
+    sequence.store(seq + 2, std::memory_order_release);
+  }
+
+  /**
+   * Returns the last published value.
+   */
+  T read() const {
+    T output;
+    std::uint32_t before, after;
+    do {
+      before = sequence.load(std::memory_order_acquire);
+      output = data;
+      std::atomic_thread_fence(std::memory_order_acquire);
+      after = sequence.load(std::memory_order_relaxed);
+    } while ((before & 1) || before != after);
+    return output;
+  }
+
+ private:
+  std::atomic<std::uint32_t> sequence{0};
+  T data{};
+};
+}  // namespace ez
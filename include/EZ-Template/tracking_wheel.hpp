@@ -6,6 +6,8 @@ file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 #pragma once
 
+#include <atomic>
+
 #include "pros/adi.hpp"
 #include "pros/rotation.hpp"
 
@@ -59,11 +61,69 @@ class tracking_wheel {
    */
   tracking_wheel(int port, double wheel_diameter, double distance_to_center = 0.0, double ratio = 1.0);
 
+  /**
+   * Copies a tracking wheel.  The copy isn't registered.
+   */
+  tracking_wheel(const tracking_wheel& other);
+
+  /**
+   * Tracking wheels can't be assigned, the PROS sensors in them can't be either.
+   */
+  tracking_wheel& operator=(const tracking_wheel& other) = delete;
+
+  ~tracking_wheel();
+
   /**
    * Returns how far the wheel has traveled in inches.
    */
   double get();
 
+  /**
+   * Returns how far the wheel had traveled in inches the last time it was read with get() or get_all().
+   */
+  double last_get();
+
+  /**
+   * Max amount of tracking wheels that can be registered.
+   */
+  static const int MAX_REGISTERED = 16;
+
+  /**
+   * Reads every registered tracking wheel back to back, in the order they were registered.  Returns how many were read.
+   *
+   * Drive registers every tracking wheel it's given, so reading them together keeps the reads close in time.
+   * Use last_get() on each tracking wheel after this to get what was read.
+   *
+   * \param output
+   *        distances in inches, can be nullptr
+   * \param max
+   *        size of output
+   */
+  static int get_all(double* output = nullptr, int max = 0);
+
+  /**
+   * Registers a tracking wheel so get_all() reads it.  Registering a wheel twice does nothing.
+   *
+   * Returns false when MAX_REGISTERED wheels are already registered.  The wheel is unregistered when it's destroyed.
+   *
+   * \param input
+   *        tracking wheel to register
+   */
+  static bool register_wheel(tracking_wheel* input);
+
+  /**
+   * Returns how many tracking wheels are registered.
+   */
+  static int registered_size();
+
+  /**
+   * Returns a registered tracking wheel.
+   *
+   * \param index
+   *        index of the tracking wheel, in the order they were registered
+   */
+  static tracking_wheel* registered_get(int index);
+
   /**
    * Returns the raw sensor value.
    */
@@ -151,6 +211,17 @@ class tracking_wheel {
 #define DRIVE_ROTATION 3
   int IS_TRACKER = 0;
 
+  /**
+   * Cached whenever the wheel diameter, ratio or ticks per rev change, so reading doesn't recompute them.
+   */
+  void ticks_per_inch_update();
+  double TICKS_PER_INCH = 0.0;
+  double INCHES_PER_TICK = 0.0;
+  std::atomic<double> LAST_DISTANCE{0.0};  // read from other tasks
+
+  static tracking_wheel* registered[MAX_REGISTERED];
+  static int registered_count;
+
   bool IS_FLIPPED = false;
 
   double DISTANCE_TO_CENTER = 0.0;
@@ -0,0 +1,97 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla Public
+License, v. 2.0. If a copy of the MPL was not distributed with this
+file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include "EZ-Template/util.hpp"
+
+namespace ez {
+/**
+ * Trapezoidal motion profile.
+ *
+ * Accelerates at max acceleration until max velocity, cruises, then decelerates so it stops
+ * exactly at the target.  Short motions that can't reach max velocity become a triangle.
+ */
+class trapezoid_profile {
+ public:
+  trapezoid_profile();
+
+  /**
+   * Struct for constants.
+   */
+  struct Constants {
+    double max_velocity = 0;
+    double max_acceleration = 0;
+  };
+  Constants constants;
+
+  /**
+   * Where the profile is at a point in time.
+   */
+  struct State {
+    double position = 0;
+    double velocity = 0;
+    double acceleration = 0;
+  };
+
+  /**
+   * Sets constants for the profile.  The profile is disabled while either is 0.
+   *
+   * \param max_velocity
+   *        fastest the profile moves, in units per second
+   * \param max_acceleration
+   *        fastest the profile speeds up and slows down, in units per second squared
+   */
+  trapezoid_profile(double max_velocity, double max_acceleration);
+
+  /**
+   * Sets constants for the profile.  The profile is disabled while either is 0.
+   *
+   * \param max_velocity
+   *        fastest the profile moves, in units per second
+   * \param max_acceleration
+   *        fastest the profile speeds up and slows down, in units per second squared
+   */
+  void constants_set(double max_velocity, double max_acceleration);
+  Constants constants_get();
+
+  /**
+   * Initializes the profile for the motion.
+   *
+   * \param enabled
+   *        true enables the profile, false disables it
+   * \param distance
+   *        how far the motion goes, this can be negative
+   */
+  void initialize(bool enabled, double distance);
+
+  /**
+   * Returns the state of the profile relative to the start of the motion.
+   *
+   * \param time
+   *        seconds since the motion started
+   */
+  State sample(double time);
+
+  /**
+   * Returns how long the profile takes in seconds.
+   */
+  double duration_get();
+
+  /**
+   * Returns true if the profile is enabled.
+   */
+  bool enabled();
+
+ private:
+  bool is_enabled = false;
+  int sign = 1;
+  double distance = 0;
+  double peak_velocity = 0;
+  double accel_time = 0;
+  double cruise_time = 0;
+};
+}  // namespace ez
@@ -10,6 +10,7 @@ file, You can obtain one at http://mozilla.org/MPL/2.0/.
 #include <stdio.h>
 #include <string.h>
 
+#include "EZ-Template/pose.hpp"
 #include "api.h"
 #include "okapi/api/units/QAngle.hpp"
 #include "okapi/api/units/QLength.hpp"
@@ -68,7 +69,8 @@ enum exit_output { RUNNING = 1,
                    BIG_EXIT = 3,
                    VELOCITY_EXIT = 4,
                    mA_EXIT = 5,
-                   ERROR_NO_CONSTANTS = 6 };
+                   ERROR_NO_CONSTANTS = 6,
+                   INTERRUPTED_EXIT = 7 };
 
 /**
  * Enum for split and single stick arcade.
@@ -108,17 +110,26 @@ enum e_angle_behavior { raw = 0,
                         shortest = 3,
                         longest = 4 };
 
-const double ANGLE_NOT_SET = 0.0000000000000000000001;
-const okapi::QAngle p_ANGLE_NOT_SET = 0.0000000000000000000001_deg;
+/**
+ * Enum for what a PID gain schedule looks up gains with.
+ */
+enum e_gain_schedule { GAIN_SCHEDULE_ERROR = 0,
+                       GAIN_SCHEDULE_SPEED = 1 };
+
+/**
+ * Enum for the math odometry uses to turn sensor changes into a new pose.
+ */
+enum e_odom_integrator { ODOM_ARC = 0,
+                         ODOM_EXPONENTIAL = 1,
+                         ODOM_LEAST_SQUARES = 2 };
 
 /**
- * Struct for coordinates.
+ * Enum for where odometry gets its heading from.
  */
-typedef struct pose {
-  double x;
-  double y;
-  double theta = ANGLE_NOT_SET;
-} pose;
+enum e_odom_heading { ODOM_HEADING_IMU = 0,
+                      ODOM_HEADING_FUSED = 1 };
+
+const okapi::QAngle p_ANGLE_NOT_SET = 0.0000000000000000000001_deg;
 
 /**
  * Struct for united coordinates.
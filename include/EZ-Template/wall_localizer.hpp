@@ -0,0 +1,168 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla Public
+License, v. 2.0. If a copy of the MPL was not distributed with this
+file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include <cstdint>
+
+#include "EZ-Template/pose.hpp"
+
+// This doesn't use PROS, so it can be run against a simulated robot on a computer
+
+namespace ez {
+/**
+ * Where a distance sensor is on the robot.  Offsets are from the center of the robot, with x to the right
+ * and y forwards, in inches.
+ */
+struct wall_sensor {
+  double x = 0.0;
+  double y = 0.0;
+  double angle = 0.0;  // direction the sensor faces, degrees clockwise from forwards
+};
+
+/**
+ * Walls of the field, in the same coordinates as odometry.  Defaults to a 144 inch field centered on 0, 0.
+ */
+struct wall_field {
+  double min_x = -72.0;
+  double min_y = -72.0;
+  double max_x = 72.0;
+  double max_y = 72.0;
+};
+
+/**
+ * Monte Carlo localization against the field walls using distance sensors.
+ *
+ * Particles are guesses of where the robot is.  Every update they move by what odometry says the robot moved,
+ * then are weighted by how well each distance sensor matches the wall it should see from there.
+ * Heading comes from odometry, only x and y are estimated.
+ *
+ * Every particle is kept in fixed arrays, so nothing allocates after this is created.
+ */
+class wall_localizer {
+ public:
+  /**
+   * Amount of particles.
+   */
+  static const int PARTICLES = 200;
+
+  /**
+   * Max amount of distance sensors.
+   */
+  static const int MAX_SENSORS = 8;
+
+  /**
+   * Readings at or past this, in inches, are treated as not seeing anything.
+   */
+  static constexpr double MAX_RANGE = 78.0;
+
+  /**
+   * Sets where the walls are.
+   *
+   * \param input
+   *        walls, in the same coordinates as odometry
+   */
+  void field_set(const wall_field& input) { field = input; }
+
+  /**
+   * Returns where the walls are.
+   */
+  wall_field field_get() const { return field; }
+
+  /**
+   * Adds a distance sensor.  Returns its index, or -1 if there are already MAX_SENSORS.
+   *
+   * \param sensor
+   *        where the sensor is on the robot
+   */
+  int sensor_add(const wall_sensor& sensor);
+
+  /**
+   * Returns how many distance sensors there are.
+   */
+  int sensor_count() const { return sensors_count; }
+
+  /**
+   * Sets the seed for the random numbers, so runs can be repeated.
+   *
+   * \param seed
+   *        anything but 0
+   */
+  void seed_set(std::uint32_t seed) { rng = seed != 0 ? seed : 1; }
+
+  /**
+   * Spreads every particle around a pose.
+   *
+   * \param center
+   *        pose to spread particles around, in inches
+   * \param spread
+   *        standard deviation of the spread, in inches
+   */
+  void reset(pose center, double spread);
+
+  /**
+   * Moves every particle by how far odometry says the robot moved, with some noise added.
+   *
+   * \param dx
+   *        change in x since the last predict(), in inches
+   * \param dy
+   *        change in y since the last predict(), in inches
+   */
+  void predict(double dx, double dy);
+
+  /**
+   * Weights every particle using distance sensor readings, then resamples when too few particles are carrying the weight.
+   * Returns false if there weren't any readings that could be used.
+   *
+   * \param theta
+   *        heading of the robot from odometry, in degrees
+   * \param ranges
+   *        reading for each sensor in inches, in the order they were added.  negative skips a sensor
+   */
+  bool update(double theta, const double* ranges);
+
+  /**
+   * Returns the weighted average of every particle.  theta is the heading from the last update().
+   */
+  pose estimate_get() const;
+
+  /**
+   * Returns how spread out the particles are, in inches.  Smaller means more certain.
+   */
+  double spread_get() const;
+
+  /**
+   * Returns the distance a sensor should read from a pose, or a negative number if it doesn't hit a wall.
+   *
+   * \param x
+   *        x of the robot, in inches
+   * \param y
+   *        y of the robot, in inches
+   * \param theta
+   *        heading of the robot, in degrees
+   * \param sensor
+   *        index of the sensor
+   */
+  double expected_range(double x, double y, double theta, int sensor) const;
+
+ private:
+  double random_uniform();
+  double random_gaussian();
+  void resample();
+
+  wall_field field;
+  wall_sensor sensors[MAX_SENSORS];
+  int sensors_count = 0;
+  std::uint32_t rng = 1;
+  double heading = 0.0;
+
+  float particle_x[PARTICLES] = {};
+  float particle_y[PARTICLES] = {};
+  float weight[PARTICLES] = {};
+  float resample_x[PARTICLES] = {};
+  float resample_y[PARTICLES] = {};
+};
+}  // namespace ez
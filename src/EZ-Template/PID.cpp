@@ -9,46 +9,63 @@ file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 using namespace ez;
 
-void PID::variables_reset() {
+// util::sgn() only takes doubles, this works for every scalar type
+template <typename Scalar>
+static int scalar_sgn(Scalar input) {
+  return (input > Scalar(0)) - (input < Scalar(0));
+}
+
+template <typename Scalar>
+void PID_T<Scalar>::variables_reset() {
   output = 0;
   target = 0;
   error = 0;
   prev_error = 0;
   integral = 0;
+  reference_velocity = 0;
+  reference_acceleration = 0;
+  reference_position = 0;
+  reference_position_enabled = false;
   time = 0;
   prev_time = 0;
 }
 
-PID::PID() {
+template <typename Scalar>
+PID_T<Scalar>::PID_T() {
   variables_reset();
   constants_set(0, 0, 0, 0);
 }
 
-PID::Constants PID::constants_get() { return constants; }
+template <typename Scalar>
+typename PID_T<Scalar>::Constants PID_T<Scalar>::constants_get() { return constants; }
 
 // PID constructor with constants
-PID::PID(double p, double i, double d, double start_i, std::string name) {
+template <typename Scalar>
+PID_T<Scalar>::PID_T(Scalar p, Scalar i, Scalar d, Scalar start_i, std::string name) {
   variables_reset();
   constants_set(p, i, d, start_i);
   name_set(name);
 }
 
 // Set PID constants
-void PID::constants_set(double p, double i, double d, double p_start_i) {
+template <typename Scalar>
+void PID_T<Scalar>::constants_set(Scalar p, Scalar i, Scalar d, Scalar p_start_i) {
   constants.kp = p;
   constants.ki = i;
   constants.kd = d;
   constants.start_i = p_start_i;
 }
 
-bool PID::constants_set_check() {
+template <typename Scalar>
+bool PID_T<Scalar>::constants_set_check() {
   if (constants.kp == 0.0 && constants.ki == 0.0 && constants.kd == 0.0 && constants.start_i == 0.0)
     return false;
   return true;
 }
 
 // Set exit condition timeouts
-void PID::exit_condition_set(int p_small_exit_time, double p_small_error, int p_big_exit_time, double p_big_error, int p_velocity_exit_time, int p_mA_timeout) {
+template <typename Scalar>
+void PID_T<Scalar>::exit_condition_set(int p_small_exit_time, double p_small_error, int p_big_exit_time, double p_big_error, int p_velocity_exit_time, int p_mA_timeout) {
   exit.small_exit_time = p_small_exit_time;
   exit.small_error = p_small_error;
   exit.big_exit_time = p_big_exit_time;
@@ -57,47 +74,245 @@ void PID::exit_condition_set(int p_small_exit_time, double p_small_error, int p_
   exit.mA_timeout = p_mA_timeout;
 }
 
-void PID::target_set(double input) { target = input; }
-double PID::target_get() { return target; }
+template <typename Scalar>
+void PID_T<Scalar>::target_set(Scalar input) { target = input; }
+template <typename Scalar>
+Scalar PID_T<Scalar>::target_get() { return target; }
 
-void PID::i_reset_toggle(bool toggle) { reset_i_sgn = toggle; }
-bool PID::i_reset_get() { return reset_i_sgn; };
+template <typename Scalar>
+void PID_T<Scalar>::i_reset_toggle(bool toggle) { reset_i_sgn = toggle; }
+template <typename Scalar>
+bool PID_T<Scalar>::i_reset_get() { return reset_i_sgn; };
 
-double PID::compute(double current) {
+template <typename Scalar>
+Scalar PID_T<Scalar>::compute(Scalar current) {
   return compute_error(target - current, current);
 }
 
-double PID::compute_error(double err, double current) {
+template <typename Scalar>
+Scalar PID_T<Scalar>::compute_error(Scalar err, Scalar current) {
   error = err;
   cur = current;
+  exit_dt = util::DELAY_TIME;
 
   return raw_compute();
 }
 
-double PID::raw_compute() {
+template <typename Scalar>
+Scalar PID_T<Scalar>::compute(Scalar current, std::uint64_t time_us) {
+  return compute_error(target - current, current, time_us);
+}
+
+template <typename Scalar>
+Scalar PID_T<Scalar>::compute_error(Scalar err, Scalar current, std::uint64_t time_us) {
+  error = err;
+  cur = current;
+  prev_time = time;
+  time = time_us;
+
+  // Treat the first compute, or a long gap, as 1 normal loop so i and d don't jump
+  const std::uint64_t period_us = (std::uint64_t)period * 1000;
+  std::uint64_t dt = time - prev_time;
+  if (prev_time == 0 || time <= prev_time || dt > period_us * 4)
+    dt = period_us;
+  exit_dt = static_cast<int>((dt + 500) / 1000);
+
+  // Gains are tuned for util::DELAY_TIME
+  return raw_compute(Scalar(static_cast<double>(dt) / (util::DELAY_TIME * 1000.0)), time);
+}
+
+template <typename Scalar>
+void PID_T<Scalar>::period_set(int p_period) { period = p_period < 1 ? 1 : p_period; }
+template <typename Scalar>
+int PID_T<Scalar>::period_get() { return period; }
+
+template <typename Scalar>
+bool PID_T<Scalar>::gain_schedule_add(Scalar breakpoint, Scalar kp, Scalar ki, Scalar kd) {
+  if (schedule.size >= GAIN_SCHEDULE_MAX) {
+    printf("Gain schedule is full, can't add more than %i points!\n", GAIN_SCHEDULE_MAX);
+    return false;
+  }
+
+  // Shift larger breakpoints up so points stay sorted
+  int index = schedule.size;
+  while (index > 0 && schedule.points[index - 1].breakpoint > breakpoint) {
+    schedule.points[index] = schedule.points[index - 1];
+    index--;
+  }
+  schedule.points[index] = {breakpoint, kp, ki, kd};
+  schedule.size++;
+  return true;
+}
+
+template <typename Scalar>
+void PID_T<Scalar>::gain_schedule_clear() { schedule.size = 0; }
+template <typename Scalar>
+void PID_T<Scalar>::gain_schedule_input_set(e_gain_schedule input) { schedule.input = input; }
+template <typename Scalar>
+bool PID_T<Scalar>::gain_schedule_enabled() { return schedule.size > 0; }
+
+template <typename Scalar>
+typename PID_T<Scalar>::Constants PID_T<Scalar>::gain_schedule_get(Scalar input) {
+  Constants output = constants;
+  if (schedule.size == 0) return output;
+
+  // Binary search for the last point at or below input.  This always runs the same amount of steps
+  int low = 0;
+  int step = 1;
+  while (step * 2 <= schedule.size) step *= 2;
+  for (; step > 0; step /= 2) {
+    int probe = low + step;
+    low = (probe < schedule.size && schedule.points[probe].breakpoint <= input) ? probe : low;
+  }
+  int high = low + 1 < schedule.size ? low + 1 : low;
+
+  // Interpolate between the 2 points, and use the closest point past either end
+  const Gains& a = schedule.points[low];
+  const Gains& b = schedule.points[high];
+  Scalar span = b.breakpoint - a.breakpoint;
+  Scalar t = span != 0 ? (input - a.breakpoint) / span : Scalar(0);
+  t = t < Scalar(0) ? Scalar(0) : (t > Scalar(1) ? Scalar(1) : t);
+
+  output.kp = a.kp + ((b.kp - a.kp) * t);
+  output.ki = a.ki + ((b.ki - a.ki) * t);
+  output.kd = a.kd + ((b.kd - a.kd) * t);
+  return output;
+}
+
+template <typename Scalar>
+void PID_T<Scalar>::feedforward_constants_set(Scalar ks, Scalar kv, Scalar ka) {
+  feedforward.ks = ks;
+  feedforward.kv = kv;
+  feedforward.ka = ka;
+}
+template <typename Scalar>
+typename PID_T<Scalar>::Feedforward PID_T<Scalar>::feedforward_constants_get() { return feedforward; }
+
+template <typename Scalar>
+bool PID_T<Scalar>::feedforward_set_check() {
+  return !(feedforward.ks == 0 && feedforward.kv == 0 && feedforward.ka == 0);
+}
+
+template <typename Scalar>
+void PID_T<Scalar>::reference_set(Scalar velocity, Scalar acceleration) {
+  reference_velocity = velocity;
+  reference_acceleration = acceleration;
+}
+
+template <typename Scalar>
+void PID_T<Scalar>::reference_position_set(Scalar position) {
+  reference_position = position;
+  reference_position_enabled = true;
+}
+template <typename Scalar>
+void PID_T<Scalar>::reference_position_clear() { reference_position_enabled = false; }
+
+template <typename Scalar>
+void PID_T<Scalar>::derivative_filter_set(Scalar time_constant) { derivative_time_constant = time_constant; }
+template <typename Scalar>
+Scalar PID_T<Scalar>::derivative_filter_get() { return derivative_time_constant; }
+
+template <typename Scalar>
+void PID_T<Scalar>::integral_limit_set(Scalar max) { integral_max = max; }
+template <typename Scalar>
+Scalar PID_T<Scalar>::integral_limit_get() { return integral_max; }
+
+// dt_scale is how many util::DELAY_TIME loops it's been since the last compute
+template <typename Scalar>
+Scalar PID_T<Scalar>::raw_compute(Scalar dt_scale, std::uint64_t time_us) {
+  using std::abs;
+
   // calculate derivative on measurement instead of error to avoid "derivative kick"
   // https://www.isa.org/intech-home/2023/june-2023/features/fundamentals-pid-control
-  derivative = cur - prev_current;
+  Scalar raw_derivative = (cur - prev_current) / dt_scale;
+
+  // First order low pass filter on derivative
+  if (derivative_time_constant != 0) {
+    Scalar dt_ms = dt_scale * Scalar(util::DELAY_TIME);
+    Scalar alpha = derivative_time_constant / (derivative_time_constant + dt_ms);
+    derivative = (derivative * alpha) + (raw_derivative * (Scalar(1) - alpha));
+  } else {
+    derivative = raw_derivative;
+  }
 
-  if (constants.ki != 0) {
+  // Use the gain schedule if there is one
+  Constants gains = constants;
+  if (schedule.size > 0)
+    gains = gain_schedule_get(schedule.input == GAIN_SCHEDULE_SPEED ? abs(derivative) : abs(error));
+
+  // When following a profile, P and I correct the error to where the profile is.  Exits still use error to the target
+  Scalar feedback_error = reference_position_enabled ? reference_position - cur : error;
+
+  if (gains.ki != 0) {
     // Only compute i when within a threshold of target
-    if (fabs(error) < constants.start_i)
-      integral += error;
+    if (abs(feedback_error) < gains.start_i)
+      integral += feedback_error * dt_scale;
 
     // Reset i when the sign of error flips
-    if (util::sgn(error) != util::sgn(prev_current) && reset_i_sgn)
+    if (scalar_sgn(feedback_error) != scalar_sgn(prev_current) && reset_i_sgn)
       integral = 0;
+
+    // Stop i from winding up past the limit
+    if (integral_max != 0) {
+      if (integral > integral_max)
+        integral = integral_max;
+      else if (integral < -integral_max)
+        integral = -integral_max;
+    }
   }
 
-  output = (error * constants.kp) + (integral * constants.ki) - (derivative * constants.kd);
+  Scalar p_out = feedback_error * gains.kp;
+  Scalar i_out = integral * gains.ki;
+  Scalar d_out = -(derivative * gains.kd);
+  output = p_out + i_out + d_out;
+
+  // Feedforward does most of the work when following a profile, so PID only corrects what's left
+  output += (feedforward.ks * Scalar(scalar_sgn(reference_velocity))) + (feedforward.kv * reference_velocity) + (feedforward.ka * reference_acceleration);
 
   prev_current = cur;
   prev_error = error;
 
+  // Record this compute
+  if (telemetry.enabled()) {
+    pid_sample sample;
+    sample.time = time_us != 0 ? time_us : pros::micros();
+    sample.target = static_cast<float>(target);
+    sample.current = static_cast<float>(cur);
+    sample.error = static_cast<float>(error);
+    sample.p = static_cast<float>(p_out);
+    sample.i = static_cast<float>(i_out);
+    sample.d = static_cast<float>(d_out);
+    sample.output = static_cast<float>(output);
+    sample.small_exit_timer = std::min(j, 65535);
+    sample.big_exit_timer = std::min(i, 65535);
+    sample.velocity_exit_timer = std::min(k, 65535);
+    sample.mA_exit_timer = std::min(l, 65535);
+    telemetry.record(sample);
+  }
+
   return output;
 }
 
-void PID::timers_reset() {
+template <typename Scalar>
+void PID_T<Scalar>::telemetry_enable(int samples) { telemetry.resize(samples); }
+template <typename Scalar>
+const pid_telemetry& PID_T<Scalar>::telemetry_get() { return telemetry; }
+
+template <typename Scalar>
+bool PID_T<Scalar>::telemetry_save(std::string path) {
+  if (path.rfind("/usd/", 0) == 0 && !ez::util::SD_CARD_ACTIVE) {
+    printf("No SD card found, can't save PID telemetry!\n");
+    return false;
+  }
+  if (!telemetry.save(path.c_str())) {
+    printf("Couldn't save PID telemetry to %s!\n", path.c_str());
+    return false;
+  }
+  return true;
+}
+
+template <typename Scalar>
+void PID_T<Scalar>::timers_reset() {
   i = 0;
   k = 0;
   j = 0;
@@ -106,12 +321,14 @@ void PID::timers_reset() {
   is_mA = false;
 }
 
-void PID::name_set(std::string p_name) {
+template <typename Scalar>
+void PID_T<Scalar>::name_set(std::string p_name) {
   name = p_name;
   name_active = name == "" ? false : true;
 }
 
-void PID::exit_condition_print(ez::exit_output exit_type) {
+template <typename Scalar>
+void PID_T<Scalar>::exit_condition_print(ez::exit_output exit_type) {
   std::cout << " ";
   if (name_active)
     std::cout << name << " PID " << exit_to_string(exit_type) << " Exit.\n";
@@ -119,19 +336,30 @@ void PID::exit_condition_print(ez::exit_output exit_type) {
     std::cout << exit_to_string(exit_type) << " Exit.\n";
 }
 
-void PID::velocity_sensor_secondary_toggle_set(bool toggle) { use_second_sensor = toggle; }
-bool PID::velocity_sensor_secondary_toggle_get() { return use_second_sensor; }
+template <typename Scalar>
+void PID_T<Scalar>::velocity_sensor_secondary_toggle_set(bool toggle) { use_second_sensor = toggle; }
+template <typename Scalar>
+bool PID_T<Scalar>::velocity_sensor_secondary_toggle_get() { return use_second_sensor; }
+
+template <typename Scalar>
+void PID_T<Scalar>::velocity_sensor_secondary_set(double secondary_sensor) { second_sensor = secondary_sensor; }
+template <typename Scalar>
+double PID_T<Scalar>::velocity_sensor_secondary_get() { return second_sensor; }
 
-void PID::velocity_sensor_secondary_set(double secondary_sensor) { second_sensor = secondary_sensor; }
-double PID::velocity_sensor_secondary_get() { return second_sensor; }
+template <typename Scalar>
+void PID_T<Scalar>::velocity_sensor_main_exit_set(double zero) { velocity_zero_main = zero; }
+template <typename Scalar>
+double PID_T<Scalar>::velocity_sensor_main_exit_get() { return velocity_zero_main; }
 
-void PID::velocity_sensor_main_exit_set(double zero) { velocity_zero_main = zero; }
-double PID::velocity_sensor_main_exit_get() { return velocity_zero_main; }
+template <typename Scalar>
+void PID_T<Scalar>::velocity_sensor_secondary_exit_set(double zero) { velocity_zero_secondary = zero; }
+template <typename Scalar>
+double PID_T<Scalar>::velocity_sensor_secondary_exit_get() { return velocity_zero_secondary; }
 
-void PID::velocity_sensor_secondary_exit_set(double zero) { velocity_zero_secondary = zero; }
-double PID::velocity_sensor_secondary_exit_get() { return velocity_zero_secondary; }
+template <typename Scalar>
+exit_output PID_T<Scalar>::exit_condition(bool print) {
+  using std::abs;
 
-exit_output PID::exit_condition(bool print) {
   // If this function is called while all exit constants are 0, print an error
   if (exit.small_error == 0 && exit.small_exit_time == 0 && exit.big_error == 0 && exit.big_exit_time == 0 && exit.velocity_exit_time == 0 && exit.mA_timeout == 0) {
     exit_condition_print(ERROR_NO_CONSTANTS);
@@ -141,7 +369,7 @@ exit_output PID::exit_condition(bool print) {
   // If the robot gets within the target, make sure it's there for small_timeout amount of time
   if (exit.small_error != 0) {
     if (abs(error) < exit.small_error) {
-      j += util::DELAY_TIME;
+      j += exit_dt;
       i = 0;  // While this is running, don't run big thresh
       if (j > exit.small_exit_time) {
         timers_reset();
@@ -157,7 +385,7 @@ exit_output PID::exit_condition(bool print) {
   // a certain amount of time, exit and continue.  This does not run while small_timeout is running
   else if (exit.big_error != 0 && exit.big_exit_time != 0) {  // Check if this condition is enabled
     if (abs(error) < exit.big_error) {
-      i += util::DELAY_TIME;
+      i += exit_dt;
       if (i > exit.big_exit_time) {
         timers_reset();
         if (print) exit_condition_print(BIG_EXIT);
@@ -171,7 +399,7 @@ exit_output PID::exit_condition(bool print) {
   // If the motor velocity is 0, the code will timeout and set interfered to true.
   if (exit.velocity_exit_time != 0) {  // Check if this condition is enabled
     if (abs(derivative) <= velocity_zero_main) {
-      k += util::DELAY_TIME;
+      k += exit_dt;
       if (k > exit.velocity_exit_time) {
         timers_reset();
         if (print) exit_condition_print(VELOCITY_EXIT);
@@ -188,7 +416,7 @@ exit_output PID::exit_condition(bool print) {
   // If the secondary sensors velocity is 0, the code will timeout and set interfered to true.
   if (exit.velocity_exit_time != 0) {  // Check if this condition is enabled
     if (abs(second_sensor) <= velocity_zero_secondary) {
-      m += util::DELAY_TIME;
+      m += exit_dt;
       if (m > exit.velocity_exit_time) {
         timers_reset();
         if (print) exit_condition_print(VELOCITY_EXIT);
@@ -204,11 +432,13 @@ exit_output PID::exit_condition(bool print) {
   return RUNNING;
 }
 
-exit_output PID::exit_condition(pros::Motor sensor, bool print) {
-  // If the motors are pulling too many mA, the code will timeout and set interfered to true.
+// If the motors are pulling too many mA, the code will timeout and set interfered to true.
+template <typename Scalar>
+exit_output PID_T<Scalar>::exit_condition_mA(bool over_current, bool print) {
   if (exit.mA_timeout != 0) {  // Check if this condition is enabled
-    if (sensor.is_over_current()) {
-      l += util::DELAY_TIME;
+    is_mA = over_current;
+    if (is_mA) {
+      l += exit_dt;
       if (l > exit.mA_timeout) {
         timers_reset();
         if (print) exit_condition_print(mA_EXIT);
@@ -222,39 +452,61 @@ exit_output PID::exit_condition(pros::Motor sensor, bool print) {
   return exit_condition(print);
 }
 
-exit_output PID::exit_condition(std::vector<pros::Motor> sensor, bool print) {
-  // If the motors are pulling too many mA, the code will timeout and set interfered to true.
-  if (exit.mA_timeout != 0) {  // Check if this condition is enabled
-    for (auto i : sensor) {
-      // Check if 1 motor is pulling too many mA
+// Motors are only read when the mA exit is enabled, and stop being read once 1 is over current
+template <typename Scalar>
+exit_output PID_T<Scalar>::exit_condition(const pros::Motor& sensor, bool print) {
+  return exit_condition_mA(exit.mA_timeout != 0 && sensor.is_over_current(), print);
+}
+
+template <typename Scalar>
+exit_output PID_T<Scalar>::exit_condition(const std::vector<pros::Motor>& sensor, bool print) {
+  bool over_current = false;
+  if (exit.mA_timeout != 0) {
+    for (const auto& i : sensor) {
       if (i.is_over_current()) {
-        is_mA = true;
+        over_current = true;
         break;
       }
-      // If all of the motors aren't drawing too many mA, keep bool false
-      else {
-        is_mA = false;
+    }
+  }
+  return exit_condition_mA(over_current, print);
+}
+
+template <typename Scalar>
+exit_output PID_T<Scalar>::exit_condition(const pros::MotorGroup& sensor, bool print) {
+  bool over_current = false;
+  if (exit.mA_timeout != 0) {
+    for (int index = 0; index < sensor.size(); index++) {
+      if (sensor.is_over_current(index)) {
+        over_current = true;
+        break;
       }
     }
-    if (is_mA) {
-      l += util::DELAY_TIME;
-      if (l > exit.mA_timeout) {
-        timers_reset();
-        if (print) exit_condition_print(mA_EXIT);
-        return mA_EXIT;
+  }
+  return exit_condition_mA(over_current, print);
+}
+
+template <typename Scalar>
+exit_output PID_T<Scalar>::exit_condition(std::span<const std::int8_t> ports, bool print) {
+  bool over_current = false;
+  if (exit.mA_timeout != 0) {
+    for (auto port : ports) {
+      if (pros::c::motor_is_over_current(port)) {
+        over_current = true;
+        break;
       }
-    } else {
-      l = 0;
     }
   }
+  return exit_condition_mA(over_current, print);
+}
 
-  return exit_condition(print);
+template <typename Scalar>
+exit_output PID_T<Scalar>::exit_condition(std::span<const bool> over_current, bool print) {
+  bool any = false;
+  for (auto i : over_current) any = any || i;
+  return exit_condition_mA(any, print);
 }
 
-exit_output PID::exit_condition(pros::MotorGroup sensor, bool print) {
-  std::vector<pros::Motor> vector_sensor;
-  for (i = 0; i < sensor.size(); i++) {
-    vector_sensor.push_back(pros::Motor(sensor.get_port(i)));
-  }
-  return exit_condition(vector_sensor, print);
-}
\ No newline at end of file
+template class ez::PID_T<double>;
+template class ez::PID_T<float>;
+template class ez::PID_T<fixed_q16>;
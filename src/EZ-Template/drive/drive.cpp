@@ -21,7 +21,9 @@ Drive::Drive(std::vector<int> left_motor_ports, std::vector<int> right_motor_por
       right_tracker(-1, -1, false),  // Default value
       left_rotation(-1),
       right_rotation(-1),
-      ez_auto([this] { this->ez_auto_task(); }) {
+      ez_auto([this] { this->ez_auto_task(); }),
+      ez_odom([this] { this->ez_odom_task(); }, TASK_PRIORITY_DEFAULT + 1),
+      ez_localize([this] { this->ez_localize_task(); }, TASK_PRIORITY_DEFAULT - 1) {
   is_tracker = DRIVE_INTEGRATED;
 
   // Set ports to a global vector
@@ -42,6 +44,7 @@ Drive::Drive(std::vector<int> left_motor_ports, std::vector<int> right_motor_por
   CARTRIDGE = ticks;
   TICK_PER_INCH = drive_tick_per_inch();
 
+  drive_output_update();
   drive_defaults_set();
 }
 
@@ -54,7 +57,9 @@ Drive::Drive(std::vector<int> left_motor_ports, std::vector<int> right_motor_por
       right_tracker(abs(right_tracker_ports[0]), abs(right_tracker_ports[1]), util::reversed_active(right_tracker_ports[0])),
       left_rotation(-1),
       right_rotation(-1),
-      ez_auto([this] { this->ez_auto_task(); }) {
+      ez_auto([this] { this->ez_auto_task(); }),
+      ez_odom([this] { this->ez_odom_task(); }, TASK_PRIORITY_DEFAULT + 1),
+      ez_localize([this] { this->ez_localize_task(); }, TASK_PRIORITY_DEFAULT - 1) {
   is_tracker = DRIVE_ADI_ENCODER;
 
   // Set ports to a global vector
@@ -75,6 +80,7 @@ Drive::Drive(std::vector<int> left_motor_ports, std::vector<int> right_motor_por
   CARTRIDGE = ticks;
   TICK_PER_INCH = drive_tick_per_inch();
 
+  drive_output_update();
   drive_defaults_set();
 }
 
@@ -87,7 +93,9 @@ Drive::Drive(std::vector<int> left_motor_ports, std::vector<int> right_motor_por
       right_tracker({expander_smart_port, abs(right_tracker_ports[0]), abs(right_tracker_ports[1])}, util::reversed_active(right_tracker_ports[0])),
       left_rotation(-1),
       right_rotation(-1),
-      ez_auto([this] { this->ez_auto_task(); }) {
+      ez_auto([this] { this->ez_auto_task(); }),
+      ez_odom([this] { this->ez_odom_task(); }, TASK_PRIORITY_DEFAULT + 1),
+      ez_localize([this] { this->ez_localize_task(); }, TASK_PRIORITY_DEFAULT - 1) {
   is_tracker = DRIVE_ADI_ENCODER;
 
   // Set ports to a global vector
@@ -108,6 +116,7 @@ Drive::Drive(std::vector<int> left_motor_ports, std::vector<int> right_motor_por
   CARTRIDGE = ticks;
   TICK_PER_INCH = drive_tick_per_inch();
 
+  drive_output_update();
   drive_defaults_set();
 }
 
@@ -120,7 +129,9 @@ Drive::Drive(std::vector<int> left_motor_ports, std::vector<int> right_motor_por
       right_tracker(-1, -1, false),  // Default value
       left_rotation(abs(left_rotation_port)),
       right_rotation(abs(right_rotation_port)),
-      ez_auto([this] { this->ez_auto_task(); }) {
+      ez_auto([this] { this->ez_auto_task(); }),
+      ez_odom([this] { this->ez_odom_task(); }, TASK_PRIORITY_DEFAULT + 1),
+      ez_localize([this] { this->ez_localize_task(); }, TASK_PRIORITY_DEFAULT - 1) {
   is_tracker = DRIVE_ROTATION;
   left_rotation.set_reversed(util::reversed_active(left_rotation_port));
   right_rotation.set_reversed(util::reversed_active(right_rotation_port));
@@ -143,6 +154,7 @@ Drive::Drive(std::vector<int> left_motor_ports, std::vector<int> right_motor_por
   CARTRIDGE = 36000;
   TICK_PER_INCH = drive_tick_per_inch();
 
+  drive_output_update();
   drive_defaults_set();
 }
 
@@ -225,14 +237,15 @@ void Drive::drive_rpm_set(double rpm) { CARTRIDGE = rpm; }
 double Drive::drive_rpm_get() { return CARTRIDGE; }
 
 void Drive::private_drive_set(int left, int right) {
+  EZ_PROFILE(drive_stage_timers[STAGE_DRIVE_SET]);
+
   if (pros::millis() < 1500) return;
 
-  for (auto i : left_motors) {
-    if (!pto_check(i)) i.move_voltage(left * (12000.0 / 127.0));  // If the motor is in the pto list, don't do anything to the motor.
-  }
-  for (auto i : right_motors) {
-    if (!pto_check(i)) i.move_voltage(right * (12000.0 / 127.0));  // If the motor is in the pto list, don't do anything to the motor.
-  }
+  // Motors in the pto list aren't in the output list, so they don't get touched
+  std::int32_t left_mV = left * (12000.0 / 127.0);
+  std::int32_t right_mV = right * (12000.0 / 127.0);
+  for (int i = 0; i < left_output_count; i++) left_output[i]->move_voltage(left_mV);
+  for (int i = 0; i < right_output_count; i++) right_output[i]->move_voltage(right_mV);
 }
 
 void Drive::drive_set(int left, int right) {
@@ -251,12 +264,9 @@ void Drive::drive_current_limit_set(int mA) {
     mA = 2500;
   }
   CURRENT_MA = mA;
-  for (auto i : left_motors) {
-    if (!pto_check(i)) i.set_current_limit(abs(mA));  // If the motor is in the pto list, don't do anything to the motor.
-  }
-  for (auto i : right_motors) {
-    if (!pto_check(i)) i.set_current_limit(abs(mA));  // If the motor is in the pto list, don't do anything to the motor.
-  }
+  // If the motor is in the pto list, don't do anything to the motor
+  for (int i = 0; i < left_output_count; i++) left_output[i]->set_current_limit(abs(mA));
+  for (int i = 0; i < right_output_count; i++) right_output[i]->set_current_limit(abs(mA));
 }
 
 int Drive::drive_current_limit_get() {
@@ -269,11 +279,13 @@ void Drive::drive_sensor_reset() {
   left_activebrakePID.target_set(0.0);
   right_activebrakePID.target_set(0.0);
 
+  // Don't let odom run while sensors are being reset
+  std::lock_guard<pros::Mutex> lock(odom_mutex);
+
   // Reset odom stuff
-  h_last = 0.0;
-  l_last = 0.0;
-  r_last = 0.0;
-  t_last = 0.0;
+  odom_tracking.lasts_reset();
+  odom_recording_event(ODOM_FRAME_LASTS_RESET);
+  odom_sensor_resets++;
 
   // Reset sensors
   left_motors.front().tare_position();
@@ -330,12 +342,44 @@ double Drive::drive_mA_left() { return left_motors.front().get_current_draw(); }
 bool Drive::drive_current_left_over() { return left_motors.front().is_over_current(); }
 
 void Drive::drive_imu_reset(double new_heading) {
+  std::lock_guard<pros::Mutex> lock(odom_mutex);
   imu.set_rotation(new_heading);
   angle_rad = util::to_rad(new_heading);
-  t_last = angle_rad;
+  odom_tracking.t_last_set(angle_rad);
+  odom_recording_event(ODOM_FRAME_T_LAST_SET, angle_rad);
+  odom_sensor_resets++;
 }
 double Drive::drive_imu_get() { return imu.get_rotation() * IMU_SCALER; }
-double Drive::drive_imu_accel_get() { return imu.get_accel().x + imu.get_accel().y; }
+double Drive::drive_imu_accel_get() {
+  pros::imu_accel_s_t accel = imu.get_accel();
+  return accel.x + accel.y;
+}
+
+// Reads every sensor once
+void Drive::sensor_frame_sample(sensor_frame* output, bool all_sensors) {
+  output->time = pros::micros();
+
+  // Every tracking wheel is read back to back
+  tracking_wheel::get_all();
+  output->tracker_left = odom_tracker_left_enabled ? odom_tracker_left->last_get() : 0.0;
+  output->tracker_right = odom_tracker_right_enabled ? odom_tracker_right->last_get() : 0.0;
+  output->tracker_front = odom_tracker_front_enabled ? odom_tracker_front->last_get() : 0.0;
+  output->tracker_back = odom_tracker_back_enabled ? odom_tracker_back->last_get() : 0.0;
+
+  // When the drive is using trackers, the trackers were just read
+  output->left = is_tracker == ODOM_TRACKER ? output->tracker_left : drive_sensor_left();
+  output->right = is_tracker == ODOM_TRACKER ? output->tracker_right : drive_sensor_right();
+
+  output->imu = drive_imu_get();
+
+  // Odometry doesn't need these
+  if (all_sensors) {
+    output->imu_accel = drive_imu_accel_get();
+    output->left_over_current = drive_current_left_over();
+    output->right_over_current = drive_current_right_over();
+  }
+}
+Drive::sensor_frame Drive::drive_sensor_frame_get() { return drive_frame_published.read(); }
 
 void Drive::drive_imu_scaler_set(double scaler) { IMU_SCALER = scaler; }
 double Drive::drive_imu_scaler_get() { return IMU_SCALER; }
@@ -416,12 +460,9 @@ bool Drive::drive_imu_calibrated() {
 // Brake modes
 void Drive::drive_brake_set(pros::motor_brake_mode_e_t brake_type) {
   CURRENT_BRAKE = brake_type;
-  for (auto i : left_motors) {
-    if (!pto_check(i)) i.set_brake_mode(brake_type);  // If the motor is in the pto list, don't do anything to the motor.
-  }
-  for (auto i : right_motors) {
-    if (!pto_check(i)) i.set_brake_mode(brake_type);  // If the motor is in the pto list, don't do anything to the motor.
-  }
+  // If the motor is in the pto list, don't do anything to the motor
+  for (int i = 0; i < left_output_count; i++) left_output[i]->set_brake_mode(brake_type);
+  for (int i = 0; i < right_output_count; i++) right_output[i]->set_brake_mode(brake_type);
 }
 
 // Get brake
@@ -437,6 +478,10 @@ void Drive::initialize() {
 
 void Drive::odom_tracker_left_set(tracking_wheel* input) {
   if (input == nullptr) return;
+  if (!tracking_wheel::register_wheel(input)) {
+    printf("Too many tracking wheels, the left tracker won't be used!\n");
+    return;
+  }
 
   odom_tracker_left = input;
   odom_tracker_left_enabled = true;
@@ -451,6 +496,10 @@ void Drive::odom_tracker_left_set(tracking_wheel* input) {
 }
 void Drive::odom_tracker_right_set(tracking_wheel* input) {
   if (input == nullptr) return;
+  if (!tracking_wheel::register_wheel(input)) {
+    printf("Too many tracking wheels, the right tracker won't be used!\n");
+    return;
+  }
 
   odom_tracker_right = input;
   odom_tracker_right_enabled = true;
@@ -462,12 +511,20 @@ void Drive::odom_tracker_right_set(tracking_wheel* input) {
 }
 void Drive::odom_tracker_front_set(tracking_wheel* input) {
   if (input == nullptr) return;
+  if (!tracking_wheel::register_wheel(input)) {
+    printf("Too many tracking wheels, the front tracker won't be used!\n");
+    return;
+  }
 
   odom_tracker_front = input;
   odom_tracker_front_enabled = true;
 }
 void Drive::odom_tracker_back_set(tracking_wheel* input) {
   if (input == nullptr) return;
+  if (!tracking_wheel::register_wheel(input)) {
+    printf("Too many tracking wheels, the back tracker won't be used!\n");
+    return;
+  }
 
   odom_tracker_back = input;
   odom_tracker_back_enabled = true;
@@ -98,99 +98,182 @@ void Drive::pid_odom_turn_exit_condition_set(okapi::QTime p_small_exit_time, oka
   pid_odom_turn_exit_condition_set(set, se, bet, be, vet, mAt, use_imu);
 }
 
+// Runs in the autonomous task after the PIDs have been computed
+void Drive::exits_iterate(e_mode current_mode) {
+  // A new motion started or a wait_until finished, start the exits over
+  int epoch = exit_epoch;
+  if (epoch != exits.epoch) {
+    exits = {};
+    exits.epoch = epoch;
+    leftPID.timers_reset();
+    rightPID.timers_reset();
+    xyPID.timers_reset();
+    current_a_odomPID.timers_reset();
+    turnPID.timers_reset();
+    swingPID.timers_reset();
+  }
+
+  // Over current flags come from this tick's frame so the motors aren't read again
+  const bool over_current[2] = {drive_frame.left_over_current, drive_frame.right_over_current};
+  std::span<const bool> both_over_current(over_current, 2);
+  std::span<const bool> left_over_current(over_current, 1);
+  std::span<const bool> right_over_current(over_current + 1, 1);
+
+  switch (current_mode) {
+    case DRIVE:
+      leftPID.velocity_sensor_secondary_set(drive_frame.imu_accel);
+      rightPID.velocity_sensor_secondary_set(drive_frame.imu_accel);
+      if (exits.left == RUNNING) exits.left = leftPID.exit_condition(left_over_current);
+      if (exits.right == RUNNING) exits.right = rightPID.exit_condition(right_over_current);
+      break;
+    case TURN ... TURN_TO_POINT:
+      turnPID.velocity_sensor_secondary_set(drive_frame.imu_accel);
+      if (exits.turn == RUNNING) exits.turn = turnPID.exit_condition(both_over_current);
+      break;
+    case SWING:
+      swingPID.velocity_sensor_secondary_set(drive_frame.imu_accel);
+      if (exits.swing == RUNNING) exits.swing = swingPID.exit_condition(current_swing == ez::LEFT_SWING ? left_over_current : right_over_current);
+      break;
+    case POINT_TO_POINT:
+    case PURE_PURSUIT:
+      xyPID.velocity_sensor_secondary_set(drive_frame.imu_accel);
+      current_a_odomPID.velocity_sensor_secondary_set(drive_frame.imu_accel);
+      if (exits.xy == RUNNING) exits.xy = xyPID.exit_condition(both_over_current);
+      if (exits.angular == RUNNING) exits.angular = current_a_odomPID.exit_condition(both_over_current);
+      break;
+    default:
+      break;
+  }
+
+  exits_published.write(exits);
+
+  for (auto& waiter : exit_waiters) {
+    pros::task_t task = waiter.load();
+    if (task != nullptr) pros::c::task_notify(task);
+  }
+}
+
+// Clears the exits on the next tick
+void Drive::exits_rearm() { exit_epoch++; }
+
+// The autonomous task would be waiting on itself, this happens when a queued motion waits
+bool Drive::wait_in_auto_task() {
+  if (pros::c::task_get_current() != (pros::task_t)ez_auto) return false;
+  printf("Waits can't be used inside of a queued motion!\n");
+  return true;
+}
+
+// A drive has passed its target once either side has, used by wait_until_drive() and the motion queue
+bool Drive::drive_target_passed(int l_sgn, int r_sgn, double l_error, double r_error) {
+  return util::sgn(l_error) != l_sgn || util::sgn(r_error) != r_sgn;
+}
+
+// Blocks until the autonomous task has run a tick with this epoch.
+// Returns false if another motion started while waiting
+bool Drive::exits_wait(int epoch, exit_state* output) {
+  if (wait_in_auto_task()) return false;
+
+  // Become a waiter before checking anything, so a tick that finishes in between still wakes this up.
+  // When every slot is taken this still works, it just wakes up on the timeout
+  pros::task_t self = pros::c::task_get_current();
+  std::atomic<pros::task_t>* slot = nullptr;
+  for (auto& waiter : exit_waiters) {
+    pros::task_t empty = nullptr;
+    if (waiter.compare_exchange_strong(empty, self)) {
+      slot = &waiter;
+      break;
+    }
+  }
+
+  bool output_current = false;
+  while (exit_epoch == epoch) {
+    // The timeout is only a fallback incase the autonomous task stops notifying
+    pros::c::task_notify_take(true, drive_task_period * 2);
+
+    *output = exits_published.read();
+    if (output->epoch == epoch) {
+      output_current = true;
+      break;
+    }
+  }
+
+  if (slot) slot->store(nullptr);
+  return output_current;
+}
+
 // User wrapper for exit condition
 void Drive::pid_wait() {
   // Let the PID run at least 1 iteration
-  pros::delay(util::DELAY_TIME);
+  int epoch = exit_epoch;
+  exit_state state;
+  if (!exits_wait(epoch, &state)) return;
 
   if (mode == DRIVE) {
-    exit_output left_exit = RUNNING;
-    exit_output right_exit = RUNNING;
-    while (left_exit == RUNNING || right_exit == RUNNING) {
-      leftPID.velocity_sensor_secondary_set(drive_imu_accel_get());
-      rightPID.velocity_sensor_secondary_set(drive_imu_accel_get());
-      left_exit = left_exit != RUNNING ? left_exit : leftPID.exit_condition(left_motors[0]);
-      right_exit = right_exit != RUNNING ? right_exit : rightPID.exit_condition(right_motors[0]);
-      pros::delay(util::DELAY_TIME);
+    while (state.left == RUNNING || state.right == RUNNING) {
+      if (!exits_wait(epoch, &state)) return;
     }
-    if (print_toggle) std::cout << "  Left: " << exit_to_string(left_exit) << " Exit, error: " << leftPID.error << "   Right: " << exit_to_string(right_exit) << " Exit, error: " << rightPID.error << "\n";
+    if (print_toggle) std::cout << "  Left: " << exit_to_string(state.left) << " Exit, error: " << leftPID.error << "   Right: " << exit_to_string(state.right) << " Exit, error: " << rightPID.error << "\n";
 
-    if (left_exit == mA_EXIT || left_exit == VELOCITY_EXIT || right_exit == mA_EXIT || right_exit == VELOCITY_EXIT) {
+    if (state.left == mA_EXIT || state.left == VELOCITY_EXIT || state.right == mA_EXIT || state.right == VELOCITY_EXIT) {
       interfered = true;
     }
   }
 
   // Odom Exits
   else if (mode == POINT_TO_POINT || mode == PURE_PURSUIT) {
-    exit_output xy_exit = RUNNING;
-    exit_output a_exit = RUNNING;
-
     // Wait until pure pursuit is on the last point, then continue as normal
     if (mode == PURE_PURSUIT) {
       while (pp_index != pp_movements.size() - 1) {
-        xyPID.velocity_sensor_secondary_set(drive_imu_accel_get());
-        current_a_odomPID.velocity_sensor_secondary_set(drive_imu_accel_get());
-        xy_exit = xy_exit != RUNNING ? xy_exit : xyPID.exit_condition({left_motors[0], right_motors[0]});
-        a_exit = a_exit != RUNNING ? a_exit : current_a_odomPID.exit_condition({left_motors[0], right_motors[0]});
-
-        if ((xy_exit == mA_EXIT || xy_exit == VELOCITY_EXIT) && (a_exit == mA_EXIT || a_exit == VELOCITY_EXIT)) {
-          if (print_toggle) std::cout << "  XY: " << exit_to_string(xy_exit) << " Exited early, error: " << xyPID.error << ".   Angle: " << exit_to_string(a_exit) << " Exited early, error: " << current_a_odomPID.error << ".\n";
+        if ((state.xy == mA_EXIT || state.xy == VELOCITY_EXIT) && (state.angular == mA_EXIT || state.angular == VELOCITY_EXIT)) {
+          if (print_toggle) std::cout << "  XY: " << exit_to_string(state.xy) << " Exited early, error: " << xyPID.error << ".   Angle: " << exit_to_string(state.angular) << " Exited early, error: " << current_a_odomPID.error << ".\n";
           break;
         }
 
-        pros::delay(util::DELAY_TIME);
+        if (!exits_wait(epoch, &state)) return;
       }
     }
 
     // When we're at the last point in PP / we're just going to point
-    while (xy_exit == RUNNING || a_exit == RUNNING) {
-      xyPID.velocity_sensor_secondary_set(drive_imu_accel_get());
-      current_a_odomPID.velocity_sensor_secondary_set(drive_imu_accel_get());
-      xy_exit = xy_exit != RUNNING ? xy_exit : xyPID.exit_condition({left_motors[0], right_motors[0]});
-      a_exit = a_exit != RUNNING ? a_exit : current_a_odomPID.exit_condition({left_motors[0], right_motors[0]});
-      pros::delay(util::DELAY_TIME);
+    while (state.xy == RUNNING || state.angular == RUNNING) {
+      if (!exits_wait(epoch, &state)) return;
     }
-    if (print_toggle) std::cout << "  XY: " << exit_to_string(xy_exit) << " Exit, error: " << xyPID.error << ".   Angle: " << exit_to_string(a_exit) << " Exit, error: " << current_a_odomPID.error << ".\n";
+    if (print_toggle) std::cout << "  XY: " << exit_to_string(state.xy) << " Exit, error: " << xyPID.error << ".   Angle: " << exit_to_string(state.angular) << " Exit, error: " << current_a_odomPID.error << ".\n";
 
-    if (xy_exit == mA_EXIT || xy_exit == VELOCITY_EXIT || a_exit == mA_EXIT || a_exit == VELOCITY_EXIT) {
+    if (state.xy == mA_EXIT || state.xy == VELOCITY_EXIT || state.angular == mA_EXIT || state.angular == VELOCITY_EXIT) {
       interfered = true;
     }
   }
 
   // Turn Exit
   else if (mode == TURN || mode == TURN_TO_POINT) {
-    exit_output turn_exit = RUNNING;
-    while (turn_exit == RUNNING) {
-      turnPID.velocity_sensor_secondary_set(drive_imu_accel_get());
-      turn_exit = turn_exit != RUNNING ? turn_exit : turnPID.exit_condition({left_motors[0], right_motors[0]});
-      pros::delay(util::DELAY_TIME);
+    while (state.turn == RUNNING) {
+      if (!exits_wait(epoch, &state)) return;
     }
-    if (print_toggle) std::cout << "  Turn: " << exit_to_string(turn_exit) << " Exit, error: " << turnPID.error << "\n";
+    if (print_toggle) std::cout << "  Turn: " << exit_to_string(state.turn) << " Exit, error: " << turnPID.error << "\n";
 
-    if (turn_exit == mA_EXIT || turn_exit == VELOCITY_EXIT) {
+    if (state.turn == mA_EXIT || state.turn == VELOCITY_EXIT) {
       interfered = true;
     }
   }
 
   // Swing Exit
   else if (mode == SWING) {
-    exit_output swing_exit = RUNNING;
-    pros::Motor& sensor = current_swing == ez::LEFT_SWING ? left_motors[0] : right_motors[0];
-    while (swing_exit == RUNNING) {
-      swingPID.velocity_sensor_secondary_set(drive_imu_accel_get());
-      swing_exit = swing_exit != RUNNING ? swing_exit : swingPID.exit_condition(sensor);
-      pros::delay(util::DELAY_TIME);
+    while (state.swing == RUNNING) {
+      if (!exits_wait(epoch, &state)) return;
     }
-    if (print_toggle) std::cout << "  Swing: " << exit_to_string(swing_exit) << " Exit, error: " << swingPID.error << "\n";
+    if (print_toggle) std::cout << "  Swing: " << exit_to_string(state.swing) << " Exit, error: " << swingPID.error << "\n";
 
-    if (swing_exit == mA_EXIT || swing_exit == VELOCITY_EXIT) {
+    if (state.swing == mA_EXIT || state.swing == VELOCITY_EXIT) {
       interfered = true;
     }
   }
 }
 
 void Drive::wait_until_drive(double target) {
-  pros::delay(10);
+  // Let the PID run at least 1 iteration
+  int epoch = exit_epoch;
+  exit_state state;
+  if (!exits_wait(epoch, &state)) return;
 
   // Make sure mode is correct
   if (!(mode == DRIVE || mode == POINT_TO_POINT || mode == PURE_PURSUIT)) {
@@ -199,48 +282,39 @@ void Drive::wait_until_drive(double target) {
   }
 
   // Calculate error between current and target (target needs to be an in between position)
+  sensor_frame frame = drive_sensor_frame_get();
   double l_tar = l_start + target;
   double r_tar = r_start + target;
-  double l_error = l_tar - drive_sensor_left();
-  double r_error = r_tar - drive_sensor_right();
+  double l_error = l_tar - frame.left;
+  double r_error = r_tar - frame.right;
   int l_sgn = util::sgn(l_error);
   int r_sgn = util::sgn(r_error);
 
-  exit_output left_exit = RUNNING;
-  exit_output right_exit = RUNNING;
-
   while (true) {
-    l_error = l_tar - drive_sensor_left();
-    r_error = r_tar - drive_sensor_right();
+    frame = drive_sensor_frame_get();
+    l_error = l_tar - frame.left;
+    r_error = r_tar - frame.right;
+
+    // Once we've past target, return
+    if (drive_target_passed(l_sgn, r_sgn, l_error, r_error)) {
+      if (print_toggle) printf("  Drive Wait Until Exit Success. Triggered at: L,R(%.2f, %.2f)  Target: L,R(%.2f, %.2f)\n", frame.left - l_start, frame.right - r_start, l_tar, r_tar);
+      exits_rearm();
+      return;
+    }
 
     // Before robot has reached target, use the exit conditions to avoid getting stuck in this while loop
-    if (util::sgn(l_error) == l_sgn || util::sgn(r_error) == r_sgn) {
-      if (left_exit == RUNNING || right_exit == RUNNING) {
-        leftPID.velocity_sensor_secondary_set(drive_imu_accel_get());
-        rightPID.velocity_sensor_secondary_set(drive_imu_accel_get());
-        left_exit = left_exit != RUNNING ? left_exit : leftPID.exit_condition(left_motors[0]);
-        right_exit = right_exit != RUNNING ? right_exit : rightPID.exit_condition(right_motors[0]);
-        pros::delay(util::DELAY_TIME);
-      } else {
-        if (print_toggle) {
-          std::cout << "  Left: " << exit_to_string(left_exit) << " Wait Until Exit Failsafe, triggered at " << drive_sensor_left() - l_start << " instead of " << l_tar << "\n";
-          std::cout << "  Right: " << exit_to_string(right_exit) << " Wait Until Exit Failsafe, triggered at " << drive_sensor_right() - r_start << " instead of " << r_tar << "\n";
-        }
-        if (left_exit == mA_EXIT || left_exit == VELOCITY_EXIT || right_exit == mA_EXIT || right_exit == VELOCITY_EXIT) {
-          interfered = true;
-        }
-        return;
+    if (state.left != RUNNING && state.right != RUNNING) {
+      if (print_toggle) {
+        std::cout << "  Left: " << exit_to_string(state.left) << " Wait Until Exit Failsafe, triggered at " << frame.left - l_start << " instead of " << l_tar << "\n";
+        std::cout << "  Right: " << exit_to_string(state.right) << " Wait Until Exit Failsafe, triggered at " << frame.right - r_start << " instead of " << r_tar << "\n";
+      }
+      if (state.left == mA_EXIT || state.left == VELOCITY_EXIT || state.right == mA_EXIT || state.right == VELOCITY_EXIT) {
+        interfered = true;
       }
-    }
-    // Once we've past target, return
-    else if (util::sgn(l_error) != l_sgn || util::sgn(r_error) != r_sgn) {
-      if (print_toggle) printf("  Drive Wait Until Exit Success. Triggered at: L,R(%.2f, %.2f)  Target: L,R(%.2f, %.2f)\n", drive_sensor_left() - l_start, drive_sensor_right() - r_start, l_tar, r_tar);
-      leftPID.timers_reset();
-      rightPID.timers_reset();
       return;
     }
 
-    pros::delay(util::DELAY_TIME);
+    if (!exits_wait(epoch, &state)) return;
   }
 }
 
@@ -252,33 +326,31 @@ void Drive::wait_until_turn_swing(double target) {
     return;
   }
 
+  // Wait for the autonomous task to sample the IMU for this motion
+  int epoch = exit_epoch;
+  exit_state state;
+  if (!exits_wait(epoch, &state)) return;
+  sensor_frame frame = drive_sensor_frame_get();
+
   // Create new target that is the shortest from current
-  target = new_turn_target_compute(target, drive_imu_get(), shortest);
+  target = new_turn_target_compute(target, frame.imu, shortest);
 
   // Calculate error between current and target (target needs to be an in between position)
-  double g_error = target - drive_imu_get();
+  double g_error = target - frame.imu;
   int g_sgn = util::sgn(g_error);
 
-  exit_output turn_exit = RUNNING;
-  exit_output swing_exit = RUNNING;
-
-  pros::Motor& sensor = current_swing == ez::LEFT_SWING ? left_motors[0] : right_motors[0];
-
   while (true) {
-    g_error = target - drive_imu_get();
+    frame = drive_sensor_frame_get();
+    g_error = target - frame.imu;
 
     // If turning...
     if (mode == TURN || mode == TURN_TO_POINT) {
       // Before robot has reached target, use the exit conditions to avoid getting stuck in this while loop
       if (util::sgn(g_error) == g_sgn) {
-        if (turn_exit == RUNNING) {
-          turnPID.velocity_sensor_secondary_set(drive_imu_accel_get());
-          turn_exit = turn_exit != RUNNING ? turn_exit : turnPID.exit_condition({left_motors[0], right_motors[0]});
-          pros::delay(util::DELAY_TIME);
-        } else {
-          if (print_toggle) std::cout << "  Turn: " << exit_to_string(turn_exit) << " Wait Until Exit Failsafe, triggered at " << drive_imu_get() << " instead of " << target << "\n";
-
-          if (turn_exit == mA_EXIT || turn_exit == VELOCITY_EXIT) {
+        if (state.turn != RUNNING) {
+          if (print_toggle) std::cout << "  Turn: " << exit_to_string(state.turn) << " Wait Until Exit Failsafe, triggered at " << frame.imu << " instead of " << target << "\n";
+
+          if (state.turn == mA_EXIT || state.turn == VELOCITY_EXIT) {
             interfered = true;
           }
           return;
@@ -286,8 +358,8 @@ void Drive::wait_until_turn_swing(double target) {
       }
       // Once we've past target, return
       else if (util::sgn(g_error) != g_sgn) {
-        if (print_toggle) printf("  Turn Wait Until Exit Success, triggered at %.2f.  Target: %.2f\n", drive_imu_get(), target);
-        turnPID.timers_reset();
+        if (print_toggle) printf("  Turn Wait Until Exit Success, triggered at %.2f.  Target: %.2f\n", frame.imu, target);
+        exits_rearm();
         return;
       }
     }
@@ -296,14 +368,10 @@ void Drive::wait_until_turn_swing(double target) {
     else {
       // Before robot has reached target, use the exit conditions to avoid getting stuck in this while loop
       if (util::sgn(g_error) == g_sgn) {
-        if (swing_exit == RUNNING) {
-          swingPID.velocity_sensor_secondary_set(drive_imu_accel_get());
-          swing_exit = swing_exit != RUNNING ? swing_exit : swingPID.exit_condition(sensor);
-          pros::delay(util::DELAY_TIME);
-        } else {
-          if (print_toggle) std::cout << "  Swing: " << exit_to_string(swing_exit) << " Wait Until Exit Failsafe, triggered at " << drive_imu_get() << " instead of " << target << "\n";
-
-          if (swing_exit == mA_EXIT || swing_exit == VELOCITY_EXIT) {
+        if (state.swing != RUNNING) {
+          if (print_toggle) std::cout << "  Swing: " << exit_to_string(state.swing) << " Wait Until Exit Failsafe, triggered at " << frame.imu << " instead of " << target << "\n";
+
+          if (state.swing == mA_EXIT || state.swing == VELOCITY_EXIT) {
             interfered = true;
           }
           return;
@@ -311,13 +379,13 @@ void Drive::wait_until_turn_swing(double target) {
       }
       // Once we've past target, return
       else if (util::sgn(g_error) != g_sgn) {
-        if (print_toggle) printf("  Swing Wait Until Exit Success, triggered at %.2f. Target: %.2f\n", drive_imu_get(), target);
-        swingPID.timers_reset();
+        if (print_toggle) printf("  Swing Wait Until Exit Success, triggered at %.2f. Target: %.2f\n", frame.imu, target);
+        exits_rearm();
         return;
       }
     }
 
-    pros::delay(util::DELAY_TIME);
+    if (!exits_wait(epoch, &state)) return;
   }
 }
 
@@ -353,36 +421,29 @@ void Drive::pid_wait_until(double target) {
 }
 
 void Drive::pid_wait_until_point(pose target) {
-  pros::delay(10);
-
-  int xy_sgn = util::sgn(is_past_target(target, odom_pose_get()));
+  // Let the PID run at least 1 iteration
+  int epoch = exit_epoch;
+  exit_state state;
+  if (!exits_wait(epoch, &state)) return;
 
-  exit_output xy_exit = RUNNING;
-  exit_output a_exit = RUNNING;
+  int xy_sgn = util::sgn(is_past_target(target, drive_sensor_frame_get().odom));
 
   while (true) {
-    xyPID.velocity_sensor_secondary_set(drive_imu_accel_get());
-    current_a_odomPID.velocity_sensor_secondary_set(drive_imu_accel_get());
-    xy_exit = xy_exit != RUNNING ? xy_exit : xyPID.exit_condition({left_motors[0], right_motors[0]});
-    a_exit = a_exit != RUNNING ? a_exit : current_a_odomPID.exit_condition({left_motors[0], right_motors[0]});
+    pose current = drive_sensor_frame_get().odom;
 
-    if (xy_exit != RUNNING && a_exit != RUNNING) {
-      if (print_toggle) {
-        std::cout << "  XY: " << exit_to_string(xy_exit) << " Wait Until Exit Failsafe, triggered at (" << odom_x_get() << ", " << odom_y_get() << ") instead of (" << target.x << ", " << target.y << ")\n";
-        xyPID.timers_reset();
-        current_a_odomPID.timers_reset();
-      }
+    if (state.xy != RUNNING && state.angular != RUNNING) {
+      if (print_toggle) std::cout << "  XY: " << exit_to_string(state.xy) << " Wait Until Exit Failsafe, triggered at (" << current.x << ", " << current.y << ") instead of (" << target.x << ", " << target.y << ")\n";
+      exits_rearm();
       return;
     }
 
-    if (util::sgn((is_past_target(target, odom_pose_get()))) != xy_sgn) {
-      if (print_toggle) printf("  XY Wait Until Exit Success, triggered at (%.2f, %.2f).  Target: (%.2f, %.2f)\n", odom_x_get(), odom_y_get(), target.x, target.y);
-      xyPID.timers_reset();
-      current_a_odomPID.timers_reset();
+    if (util::sgn((is_past_target(target, current))) != xy_sgn) {
+      if (print_toggle) printf("  XY Wait Until Exit Success, triggered at (%.2f, %.2f).  Target: (%.2f, %.2f)\n", current.x, current.y, target.x, target.y);
+      exits_rearm();
       return;
     }
 
-    pros::delay(util::DELAY_TIME);
+    if (!exits_wait(epoch, &state)) return;
   }
 }
 
@@ -393,30 +454,25 @@ void Drive::pid_wait_until(united_pose target) { pid_wait_until_point(target); }
 // wait for pp
 void Drive::pid_wait_until_index_started(int index) {
   // Let the PID run at least 1 iteration
-  pros::delay(util::DELAY_TIME);
+  int epoch = exit_epoch;
+  exit_state state;
+  if (!exits_wait(epoch, &state)) return;
 
   if (index > injected_pp_index.size() - 2 || index < 0)
     printf("  Wait Until PP Error!  Index %i is not within range!  %i is max!\n", index, injected_pp_index.size() - 2);
   index += 1;
 
-  exit_output xy_exit = RUNNING;
-  exit_output a_exit = RUNNING;
   while (pp_index < injected_pp_index[index]) {
-    xyPID.velocity_sensor_secondary_set(drive_imu_accel_get());
-    current_a_odomPID.velocity_sensor_secondary_set(drive_imu_accel_get());
-    xy_exit = xy_exit != RUNNING ? xy_exit : xyPID.exit_condition({left_motors[0], right_motors[0]});
-    a_exit = a_exit != RUNNING ? a_exit : current_a_odomPID.exit_condition({left_motors[0], right_motors[0]});
-
-    if (xy_exit != RUNNING && a_exit != RUNNING) {
+    if (state.xy != RUNNING && state.angular != RUNNING) {
       if (print_toggle) {
-        std::cout << "  XY: " << exit_to_string(xy_exit) << " Wait Until Exit Failsafe, triggered at (" << odom_x_get() << ", " << odom_y_get() << ") instead of (" << pp_movements[index].target.x << ", " << pp_movements[index].target.y << ")\n";
-        xyPID.timers_reset();
-        current_a_odomPID.timers_reset();
+        pose current = drive_sensor_frame_get().odom;
+        std::cout << "  XY: " << exit_to_string(state.xy) << " Wait Until Exit Failsafe, triggered at (" << current.x << ", " << current.y << ") instead of (" << pp_movements[index].target.x << ", " << pp_movements[index].target.y << ")\n";
       }
+      exits_rearm();
       break;
     }
 
-    pros::delay(util::DELAY_TIME);
+    if (!exits_wait(epoch, &state)) return;
   }
 }
 
@@ -479,6 +535,17 @@ double Drive::pid_swing_chain_backward_constant_get() { return swing_backward_mo
 
 // Pid wait that hold momentum into the next motion
 void Drive::pid_wait_quick_chain() {
+  if (!motion_chain_extend()) {
+    printf("Not in a supported drive mode!\n");
+    return;
+  }
+
+  // Exit at the real target
+  pid_wait_quick();
+}
+
+// Adds the chain constant to the current target so the robot carries momentum past the real target
+bool Drive::motion_chain_extend() {
   // If driving, add drive_motion_chain_scale to target
   if (mode == DRIVE) {
     double chain_scale = motion_chain_backward ? drive_backward_motion_chain_scale : drive_forward_motion_chain_scale;
@@ -525,10 +592,8 @@ void Drive::pid_wait_quick_chain() {
                               pp_movements[pp_movements.size() - 1].max_xy_speed});
 
   } else {
-    printf("Not in a supported drive mode!\n");
-    return;
+    return false;
   }
 
-  // Exit at the real target
-  pid_wait_quick();
+  return true;
 }
@@ -0,0 +1,116 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla Public
+License, v. 2.0. If a copy of the MPL was not distributed with this
+file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include "EZ-Template/drive/drive.hpp"
+#include "EZ-Template/util.hpp"
+#include "EZ-Template/wall_localizer.hpp"
+
+using namespace ez;
+
+// Sets and gets
+void Drive::odom_wall_sensor_add(pros::Distance* input, double x, double y, double angle) {
+  std::lock_guard<pros::Mutex> lock(wall_mutex);
+  int index = localizer.sensor_add({x, y, angle});
+  if (index < 0) {
+    printf("Too many wall distance sensors, this one won't be used!\n");
+    return;
+  }
+  wall_sensors[index] = input;
+}
+void Drive::odom_wall_field_set(double min_x, double min_y, double max_x, double max_y) {
+  std::lock_guard<pros::Mutex> lock(wall_mutex);
+  localizer.field_set({fmin(min_x, max_x), fmin(min_y, max_y), fmax(min_x, max_x), fmax(min_y, max_y)});
+}
+void Drive::odom_wall_localization_enable(bool input) {
+  if (input && !wall_enabled) wall_reset = true;
+  wall_enabled = input;
+}
+bool Drive::odom_wall_localization_enabled() { return wall_enabled; }
+void Drive::odom_wall_localization_blend_set(double blend) { wall_blend = util::clamp(blend, 1.0, 0.0); }
+double Drive::odom_wall_localization_blend_get() { return wall_blend; }
+void Drive::odom_wall_localization_spread_max_set(double spread) { wall_spread_max = fabs(spread); }
+double Drive::odom_wall_localization_spread_max_get() { return wall_spread_max; }
+void Drive::odom_wall_localization_latency_set(int latency) { wall_latency = latency < 0 ? 0 : latency; }
+void Drive::odom_wall_localization_latency_set(okapi::QTime p_latency) { odom_wall_localization_latency_set((int)p_latency.convert(okapi::millisecond)); }
+int Drive::odom_wall_localization_latency_get() { return wall_latency; }
+pose Drive::odom_wall_localization_pose_get() { return wall_published.read().odom; }
+double Drive::odom_wall_localization_spread_get() { return wall_published.read().spread; }
+
+// Moves odometry without counting as the robot moving
+void Drive::odom_correction_apply(double dx, double dy) {
+  std::lock_guard<pros::Mutex> lock(odom_mutex);
+  odom_current.x += dx;
+  odom_current.y += dy;
+  odom_tracking.shift(dx, dy);
+
+  // History moves too, otherwise the jump looks like speed to odom_pose_predict() and odom_pose_at()
+  int count = odom_history_count.load(std::memory_order_relaxed);
+  for (int i = 0; i < count && i < ODOM_HISTORY_SIZE; i++) {
+    timed_pose past = odom_history[i].read();
+    past.odom.x += dx;
+    past.odom.y += dy;
+    odom_history[i].write(past);
+  }
+
+  odom_recording_event(ODOM_FRAME_X_SHIFT, dx);
+  odom_recording_event(ODOM_FRAME_Y_SHIFT, dy);
+  was_odom_just_set = true;
+  odom_published.write(odom_current);
+}
+
+// Wall localization task
+void Drive::ez_localize_task() {
+  pose last_odom = {0.0, 0.0, 0.0};
+  while (true) {
+    pros::delay(50);
+
+    if (!wall_enabled || !imu_calibration_complete || !odometry_enabled) {
+      wall_reset = true;
+      continue;
+    }
+
+    std::lock_guard<pros::Mutex> lock(wall_mutex);
+    int count = localizer.sensor_count();
+    if (count == 0) continue;
+
+    // Read every distance sensor back to back, 9999 is when nothing is seen
+    double ranges[wall_localizer::MAX_SENSORS];
+    for (int i = 0; i < count; i++) {
+      std::int32_t mm = wall_sensors[i]->get_distance();
+      ranges[i] = mm <= 0 || mm >= 9999 ? -1.0 : mm / 25.4;
+    }
+
+    // Readings were measured a little before they were read, so use where odometry was then
+    std::uint64_t now = pros::micros();
+    std::uint64_t latency = (std::uint64_t)wall_latency * 1000;
+    pose odom = odom_pose_at(now > latency ? now - latency : 0);
+
+    // Start over around odometry when it was set
+    if (wall_reset.exchange(false)) {
+      localizer.reset(odom, 2.0);
+      last_odom = odom;
+    }
+
+    localizer.predict(odom.x - last_odom.x, odom.y - last_odom.y);
+    last_odom = odom;
+    if (!localizer.update(odom.theta, ranges)) continue;
+
+    wall_estimate estimate;
+    estimate.odom = localizer.estimate_get();
+    estimate.spread = localizer.spread_get();
+    wall_published.write(estimate);
+
+    // Only correct once the particles agree
+    if (estimate.spread > wall_spread_max) continue;
+    double dx = (estimate.odom.x - odom.x) * wall_blend;
+    double dy = (estimate.odom.y - odom.y) * wall_blend;
+    odom_correction_apply(dx, dy);
+
+    // The correction isn't the robot moving
+    last_odom.x += dx;
+    last_odom.y += dy;
+  }
+}
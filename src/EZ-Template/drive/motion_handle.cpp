@@ -0,0 +1,151 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla Public
+License, v. 2.0. If a copy of the MPL was not distributed with this
+file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include "EZ-Template/drive/motion_handle.hpp"
+
+#include <mutex>
+
+#include "EZ-Template/drive/drive.hpp"
+
+using namespace ez;
+
+/////
+// Motion tracking inside of Drive
+/////
+
+// Picks which exit to report when a motion has two, interference wins
+static bool exit_interfered(exit_output input) { return input == mA_EXIT || input == VELOCITY_EXIT; }
+static exit_output exit_pick(exit_output a, exit_output b) {
+  if (a == RUNNING || b == RUNNING) return RUNNING;
+  return exit_interfered(b) && !exit_interfered(a) ? b : a;
+}
+
+// Decides if the current motion is done, the same way pid_wait() does
+exit_output Drive::motion_exit_compute(e_mode current_mode) {
+  switch (current_mode) {
+    case DRIVE:
+      return exit_pick(exits.left, exits.right);
+    case TURN ... TURN_TO_POINT:
+      return exits.turn;
+    case SWING:
+      return exits.swing;
+    case POINT_TO_POINT:
+      return exit_pick(exits.xy, exits.angular);
+    case PURE_PURSUIT:
+      // Pure pursuit finishes early if both PIDs are stuck, otherwise it has to be on the last point
+      if (exit_interfered(exits.xy) && exit_interfered(exits.angular)) return exit_pick(exits.xy, exits.angular);
+      if (pp_index != (int)pp_movements.size() - 1) return RUNNING;
+      return exit_pick(exits.xy, exits.angular);
+    default:
+      return RUNNING;
+  }
+}
+
+// Runs in the autonomous task after exits are checked
+void Drive::motion_iterate(e_mode current_mode, int current_motion) {
+  if (current_mode == DISABLE) return;
+
+  exit_output exit = motion_exit_compute(current_mode);
+  if (exit == RUNNING) return;
+
+  std::function<void()> callback;
+  {
+    std::lock_guard<pros::Mutex> lock(motion_mutex);
+    motion_record& record = motion_history[current_motion % MOTION_HISTORY];
+
+    // The mode can still be the last motion's on the tick the id goes up
+    if (record.id != current_motion || record.mode != current_mode || record.exit != RUNNING) return;
+    record.exit = exit;
+    if (motion_callback_id == current_motion) callback = std::move(motion_callback);
+    motion_callback = nullptr;
+  }
+
+  // This runs without the mutex held so the callback can start a new motion
+  if (callback) callback();
+}
+
+// Runs every time drive_mode_set() is called, before the new mode is set
+void Drive::motion_start(e_mode p_mode) {
+  std::lock_guard<pros::Mutex> lock(motion_mutex);
+
+  // Whatever was running didn't get to finish
+  int last = motion_id;
+  motion_record& last_record = motion_history[last % MOTION_HISTORY];
+  if (last_record.id == last && last_record.exit == RUNNING) last_record.exit = INTERRUPTED_EXIT;
+  motion_callback = nullptr;
+
+  int id = last + 1;
+  motion_history[id % MOTION_HISTORY] = {id, p_mode, p_mode == DISABLE ? INTERRUPTED_EXIT : RUNNING};
+  motion_id = id;
+}
+
+exit_output Drive::motion_exit_get(int id) {
+  std::lock_guard<pros::Mutex> lock(motion_mutex);
+  const motion_record& record = motion_history[id % MOTION_HISTORY];
+  if (record.id == id) return record.exit;
+  return INTERRUPTED_EXIT;  // This motion is too old to be remembered
+}
+
+motion_handle Drive::motion_current() { return motion_handle(this, motion_id); }
+
+/////
+// Handles
+/////
+motion_handle::motion_handle(Drive* drive, int id) : drive(drive), id(id) {}
+
+bool motion_handle::current() { return drive != nullptr && drive->motion_id == id; }
+int motion_handle::id_get() { return id; }
+
+exit_output motion_handle::exit_get() {
+  if (drive == nullptr) return INTERRUPTED_EXIT;
+  return drive->motion_exit_get(id);
+}
+bool motion_handle::done() { return exit_get() != RUNNING; }
+
+void motion_handle::wait() {
+  if (current() && !done()) drive->pid_wait();
+}
+void motion_handle::wait_until(double target) {
+  if (current() && !done()) drive->pid_wait_until(target);
+}
+void motion_handle::wait_until(okapi::QLength target) {
+  if (current() && !done()) drive->pid_wait_until(target);
+}
+void motion_handle::wait_until(okapi::QAngle target) {
+  if (current() && !done()) drive->pid_wait_until(target);
+}
+void motion_handle::wait_until(pose target) {
+  if (current() && !done()) drive->pid_wait_until(target);
+}
+void motion_handle::wait_until(united_pose target) {
+  if (current() && !done()) drive->pid_wait_until(target);
+}
+
+void motion_handle::cancel() {
+  if (current()) drive->drive_mode_set(DISABLE);
+}
+
+void motion_handle::complete_callback_set(std::function<void()> callback) {
+  if (drive == nullptr) return;
+
+  {
+    std::lock_guard<pros::Mutex> lock(drive->motion_mutex);
+    const Drive::motion_record& record = drive->motion_history[id % Drive::MOTION_HISTORY];
+
+    // Still running, the autonomous task will run this when it exits
+    if (record.id == id && record.exit == RUNNING) {
+      drive->motion_callback = callback;
+      drive->motion_callback_id = id;
+      return;
+    }
+
+    // Interrupted motions don't run their callback
+    if (record.id != id || record.exit == INTERRUPTED_EXIT) return;
+  }
+
+  // The motion already exited
+  callback();
+}
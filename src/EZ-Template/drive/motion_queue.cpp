@@ -0,0 +1,143 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla Public
+License, v. 2.0. If a copy of the MPL was not distributed with this
+file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include <mutex>
+
+#include "EZ-Template/drive/drive.hpp"
+#include "EZ-Template/util.hpp"
+
+using namespace ez;
+
+void Drive::motion_queue(std::vector<std::function<void()>> motions) {
+  std::lock_guard<pros::Mutex> lock(motion_queue_mutex);
+  motion_queue_list = std::move(motions);
+  motion_queue_index = 0;
+  queue_chain = {};
+}
+
+void Drive::motion_queue_clear() {
+  std::lock_guard<pros::Mutex> lock(motion_queue_mutex);
+  motion_queue_list.clear();
+  motion_queue_index = 0;
+  queue_chain = {};
+}
+
+int Drive::motion_queue_size_get() {
+  std::lock_guard<pros::Mutex> lock(motion_queue_mutex);
+  return motion_queue_list.size() - motion_queue_index;
+}
+
+void Drive::motion_queue_wait() {
+  if (wait_in_auto_task()) return;
+
+  // Wake up every tick until the last motion has started
+  while (motion_queue_size_get() != 0) {
+    exit_state state;
+    exits_wait(exit_epoch, &state);
+  }
+
+  pid_wait();
+}
+
+// Runs at the start of a tick in the autonomous task, returns true if it started a motion
+bool Drive::motion_queue_iterate(e_mode current_mode) {
+  std::function<void()> next;
+  bool last = false;
+  {
+    std::lock_guard<pros::Mutex> lock(motion_queue_mutex);
+    if (motion_queue_index >= motion_queue_list.size()) return false;
+
+    // The first motion starts right away, the rest wait for the current one to pass its target
+    if (queue_chain.active && !motion_chain_passed(current_mode)) return false;
+
+    next = std::move(motion_queue_list[motion_queue_index]);
+    motion_queue_index++;
+    last = motion_queue_index >= motion_queue_list.size();
+    if (last) {
+      motion_queue_list.clear();
+      motion_queue_index = 0;
+    }
+  }
+
+  // Start the motion without the lock held, drive_mode_set() doesn't clear the queue from this task
+  if (next) next();
+
+  // Everything but the last motion hands off to the next one early
+  std::lock_guard<pros::Mutex> lock(motion_queue_mutex);
+  queue_chain = {};
+  if (!last) motion_chain_start();
+  return true;
+}
+
+// Extends the target of the motion that just started and remembers what side of the real target the robot is on
+void Drive::motion_chain_start() {
+  queue_chain.active = true;
+  queue_chain.mode = mode;
+
+  // Modes that can't chain move on once they exit
+  queue_chain.extended = motion_chain_extend();
+  if (!queue_chain.extended) return;
+
+  switch (queue_chain.mode) {
+    case DRIVE:
+      queue_chain.left = l_start + chain_target_start;
+      queue_chain.right = r_start + chain_target_start;
+      queue_chain.sgn_left = util::sgn(queue_chain.left - drive_frame.left);
+      queue_chain.sgn_right = util::sgn(queue_chain.right - drive_frame.right);
+      break;
+    case TURN:
+    case SWING:
+      queue_chain.angle = new_turn_target_compute(chain_target_start, drive_frame.imu, shortest);
+      queue_chain.sgn = util::sgn(queue_chain.angle - drive_frame.imu);
+      break;
+    case POINT_TO_POINT:
+      queue_chain.point = odom_target_start;
+      queue_chain.sgn = util::sgn(is_past_target(queue_chain.point, drive_frame.odom));
+      queue_chain.point_started = true;
+      break;
+    case PURE_PURSUIT:
+      // This is the real last point, the extended point was added after it
+      queue_chain.point = pp_movements[injected_pp_index.back()].target;
+      break;
+    default:
+      break;
+  }
+}
+
+// The same checks as pid_wait_quick(), using this tick's sensors
+bool Drive::motion_chain_passed(e_mode current_mode) {
+  // Something else took over the drive
+  if (current_mode != queue_chain.mode) return true;
+
+  if (!queue_chain.extended) return motion_exit_compute(current_mode) != RUNNING;
+
+  switch (queue_chain.mode) {
+    case DRIVE: {
+      // Exit conditions are a failsafe incase the robot gets stuck
+      if (exits.left != RUNNING && exits.right != RUNNING) return true;
+      return drive_target_passed(queue_chain.sgn_left, queue_chain.sgn_right, queue_chain.left - drive_frame.left, queue_chain.right - drive_frame.right);
+    }
+    case TURN:
+    case SWING: {
+      exit_output exit = queue_chain.mode == TURN ? exits.turn : exits.swing;
+      if (exit != RUNNING) return true;
+      return util::sgn(queue_chain.angle - drive_frame.imu) != queue_chain.sgn;
+    }
+    case POINT_TO_POINT:
+    case PURE_PURSUIT:
+      if (exits.xy != RUNNING && exits.angular != RUNNING) return true;
+
+      // Pure pursuit has to be heading to the last point before it can pass it
+      if (!queue_chain.point_started) {
+        if (pp_index < injected_pp_index.back()) return false;
+        queue_chain.sgn = util::sgn(is_past_target(queue_chain.point, drive_frame.odom));
+        queue_chain.point_started = true;
+      }
+      return util::sgn(is_past_target(queue_chain.point, drive_frame.odom)) != queue_chain.sgn;
+    default:
+      return true;
+  }
+}
@@ -10,52 +10,173 @@ file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 using namespace ez;
 
+// Autonomous task timing
+void Drive::drive_task_period_set(int period) {
+  drive_task_period = period < 1 ? 1 : period;
+  drive_task_timing_reset();
+
+  // The PIDs computed in the drive task need to know how often that is
+  PID* task_pids[] = {&headingPID, &turnPID, &leftPID, &rightPID, &forward_drivePID, &backward_drivePID, &fwd_rev_drivePID,
+                      &swingPID, &forward_swingPID, &backward_swingPID, &fwd_rev_swingPID, &xyPID, &current_a_odomPID,
+                      &boomerangPID, &odom_angularPID, &internal_leftPID, &internal_rightPID};
+  for (PID* pid : task_pids) pid->period_set(drive_task_period);
+}
+void Drive::drive_task_period_set(okapi::QTime p_period) { drive_task_period_set((int)p_period.convert(okapi::millisecond)); }
+int Drive::drive_task_period_get() { return drive_task_period; }
+Drive::task_timing Drive::drive_task_timing_get() { return drive_timing; }
+void Drive::drive_task_timing_reset() {
+  drive_timing = {};
+  drive_timing.period = drive_task_period;
+  drive_timing_last_tick = 0;
+}
+
+// Keeps track of how far the start of each tick is from where it should be
+void Drive::task_timing_iterate(task_timing* timing, std::uint64_t* last_tick, std::uint64_t now) {
+  if (*last_tick != 0) {
+    double jitter = (double)(now - *last_tick) - (timing->period * 1000.0);
+    timing->jitter_last = jitter;
+    if (timing->ticks == 0 || jitter < timing->jitter_min) timing->jitter_min = jitter;
+    if (timing->ticks == 0 || jitter > timing->jitter_max) timing->jitter_max = jitter;
+    timing->ticks++;
+    timing->jitter_mean += (jitter - timing->jitter_mean) / timing->ticks;
+  }
+  *last_tick = now;
+}
+
+// Sleeps until the next deadline.  If this tick ran past the next deadline,
+// the missed ticks are skipped instead of running them back to back
+void Drive::task_deadline_wait(task_timing* timing, std::uint32_t* next_wake) {
+  std::uint32_t period = timing->period;
+  std::uint32_t late = pros::millis() - *next_wake;
+  if (late >= period) {
+    timing->missed_deadlines += late / period;
+    *next_wake += (late / period) * period;
+  }
+  pros::Task::delay_until(next_wake, period);
+}
+
+// Per stage timing
+stage_timer::stats Drive::drive_task_stage_get(e_stage stage) {
+  if (stage < 0 || stage >= STAGE_COUNT) return {};
+  return drive_stage_timers[stage].get();
+}
+void Drive::drive_task_stages_reset() {
+  for (auto& i : drive_stage_timers) i.reset();
+}
+void Drive::drive_task_stages_print_period_set(int period) { drive_stages_print_period = period < 0 ? 0 : period; }
+void Drive::drive_task_stages_print() {
+  printf("%-16s %8s %8s %8s %8s\n", "Stage (us)", "count", "min", "mean", "max");
+  for (int i = 0; i < STAGE_COUNT; i++) {
+    stage_timer::stats stats = drive_stage_timers[i].get();
+    printf("%-16s %8i %8lu %8.1f %8lu\n", stage_to_string((e_stage)i).c_str(), stats.count, (unsigned long)stats.min, stats.mean, (unsigned long)stats.max);
+  }
+}
+
 void Drive::ez_auto_task() {
+  std::uint32_t next_wake = pros::millis();
   while (true) {
-    // Run odom
-    ez_tracking_task();
-
-    // Autonomous PID
-    switch (drive_mode_get()) {
-      case DRIVE:
-        drive_pid_task();
-        break;
-      case TURN ... TURN_TO_POINT:
-        turn_pid_task();
-        break;
-      case SWING:
-        swing_pid_task();
-        break;
-      case POINT_TO_POINT:
-        ptp_task();
-        break;
-      case PURE_PURSUIT:
-        pp_task();
-        break;
-      case DISABLE:
-        break;
-      default:
-        break;
+    // Pick up period changes at the start of a tick
+    if (drive_timing.period != drive_task_period) drive_task_timing_reset();
+    task_timing_iterate(&drive_timing, &drive_timing_last_tick, pros::micros());
+
+    {
+      EZ_PROFILE(drive_stage_timers[STAGE_TICK]);
+
+      // The mode is read once so the sensors sampled match the motion that runs.
+      // The mode is read first, the id goes up before the mode changes so a new mode always comes with its id
+      e_mode current_mode = drive_mode_get();
+      int current_motion = motion_id;
+
+      // Read every sensor once, everything below uses this frame
+      drive_frame.odom = odom_pose_get();
+      drive_frame.odom_predicted = drive_frame.odom;
+      if (current_mode != DISABLE || motion_queue_size_get() != 0) {
+        sensor_frame_sample(&drive_frame);
+        if (odom_latency != 0) drive_frame.odom_predicted = odom_pose_predict_at(drive_frame.time + ((std::uint64_t)odom_latency * 1000));
+        drive_frame_published.write(drive_frame);
+      }
+
+      // The next queued motion starts in the same tick the last one hands off
+      if (motion_queue_iterate(current_mode)) {
+        current_mode = drive_mode_get();
+        current_motion = motion_id;
+      }
+
+      // Odom runs in its own task, this keeps the xy PID's sensor value up to date
+      xy_fake_iterate();
+
+      // Autonomous PID
+      switch (current_mode) {
+        case DRIVE:
+          drive_pid_task();
+          break;
+        case TURN ... TURN_TO_POINT:
+          turn_pid_task();
+          break;
+        case SWING:
+          swing_pid_task();
+          break;
+        case POINT_TO_POINT:
+          ptp_task();
+          break;
+        case PURE_PURSUIT:
+          pp_task();
+          break;
+        case DISABLE:
+          break;
+        default:
+          break;
+      }
+
+      // Check exit conditions and wake up whatever is waiting on this motion
+      exits_iterate(current_mode);
+      motion_iterate(current_mode, current_motion);
+
+      // This is used to reset sensors for active braking
+      util::AUTON_RAN = current_mode != DISABLE ? true : false;
     }
 
-    // This is used to reset sensors for active braking
-    util::AUTON_RAN = drive_mode_get() != DISABLE ? true : false;
+    // Periodically dump stage timing
+    if (drive_stages_print_period != 0 && pros::millis() - drive_stages_last_print >= (std::uint32_t)drive_stages_print_period) {
+      drive_stages_last_print = pros::millis();
+      drive_task_stages_print();
+    }
 
-    pros::delay(ez::util::DELAY_TIME);
+    task_deadline_wait(&drive_timing, &next_wake);
   }
 }
 
+// Feeds a profile into a PID on this loop.  PID follows where the profile is, and once the profile
+// is done it goes back to the target so chained motions still carry past it
+void Drive::profile_follow(trapezoid_profile* profile, std::uint64_t start, double start_position, PID* pid) {
+  double time = drive_frame.time > start ? (drive_frame.time - start) / 1000000.0 : 0.0;
+  trapezoid_profile::State reference = profile->sample(time);
+  pid->reference_set(reference.velocity, reference.acceleration);
+  if (time < profile->duration_get())
+    pid->reference_position_set(start_position + reference.position);
+  else
+    pid->reference_position_clear();
+}
+
 // Drive PID task
 void Drive::drive_pid_task() {
+  EZ_PROFILE(drive_stage_timers[STAGE_DRIVE_PID]);
+
+  // Feed the profile forward so PID only corrects what's left
+  if (drive_profile.enabled()) {
+    profile_follow(&drive_profile, drive_profile_start, l_start, &leftPID);
+    profile_follow(&drive_profile, drive_profile_start, r_start, &rightPID);
+  }
+
   // Compute PID
-  leftPID.compute(drive_sensor_left());
-  rightPID.compute(drive_sensor_right());
+  leftPID.compute(drive_frame.left, drive_frame.time);
+  rightPID.compute(drive_frame.right, drive_frame.time);
 
-  headingPID.compute(drive_imu_get());
+  headingPID.compute(drive_frame.imu, drive_frame.time);
 
   // Compute slew
-  slew_left.iterate(drive_sensor_left());
-  slew_right.iterate(drive_sensor_right());
+  slew_left.iterate(drive_frame.left);
+  slew_right.iterate(drive_frame.right);
 
   // Left and Right outputs
   double l_drive_out = leftPID.output;
@@ -91,26 +212,32 @@ void Drive::drive_pid_task() {
 
 // Turn PID task
 void Drive::turn_pid_task() {
+  EZ_PROFILE(drive_stage_timers[STAGE_TURN_PID]);
+
   // Compute PID if it's a normal turn
   if (mode == TURN) {
-    turnPID.compute(drive_imu_get());
+    // Feed the profile forward so PID only corrects what's left
+    if (turn_profile.enabled())
+      profile_follow(&turn_profile, turn_profile_start, chain_sensor_start, &turnPID);
+    turnPID.compute(drive_frame.imu, drive_frame.time);
   }
   // Compute PID if we're turning to point
   else {
-    double a_target = util::absolute_angle_to_point(point_to_face[!ptf1_running], odom_pose_get());  // Calculate the point for angle to face
+    double a_target = util::absolute_angle_to_point(point_to_face[!ptf1_running], drive_frame.odom);  // Calculate the point for angle to face
     a_target = new_turn_target_compute(a_target, odom_imu_start, current_angle_behavior);
-    double error = a_target - odom_theta_get();
-    turnPID.compute_error(error, odom_theta_get());
+    double error = a_target - drive_frame.odom.theta;
+    turnPID.compute_error(error, drive_frame.odom.theta, drive_frame.time);
   }
 
   // Compute slew
-  slew_turn.iterate(drive_imu_get());
+  slew_turn.iterate(drive_frame.imu);
 
   // Clip gyroPID to max speed
   double gyro_out = util::clamp(turnPID.output, slew_turn.output(), -slew_turn.output());
 
   // Clip the speed of the turn when the robot is within StartI, only do this when target is larger then StartI
-  if (turnPID.constants.ki != 0 && (fabs(turnPID.target_get()) > turnPID.constants.start_i && fabs(turnPID.error) < turnPID.constants.start_i)) {
+  // A gain schedule softens the turn near target on its own, so this isn't needed with one
+  if (!turnPID.gain_schedule_enabled() && turnPID.constants.ki != 0 && (fabs(turnPID.target_get()) > turnPID.constants.start_i && fabs(turnPID.error) < turnPID.constants.start_i)) {
     if (pid_turn_min_get() != 0)
       gyro_out = util::clamp(gyro_out, pid_turn_min_get(), -pid_turn_min_get());
   }
@@ -122,20 +249,23 @@ void Drive::turn_pid_task() {
 
 // Swing PID task
 void Drive::swing_pid_task() {
+  EZ_PROFILE(drive_stage_timers[STAGE_SWING_PID]);
+
   // Compute PID
-  swingPID.compute(drive_imu_get());
-  leftPID.compute(drive_sensor_left());
-  rightPID.compute(drive_sensor_right());
+  swingPID.compute(drive_frame.imu, drive_frame.time);
+  leftPID.compute(drive_frame.left, drive_frame.time);
+  rightPID.compute(drive_frame.right, drive_frame.time);
 
   // Compute slew
-  double current = slew_swing_using_angle ? drive_imu_get() : (current_swing == LEFT_SWING ? drive_sensor_left() : drive_sensor_right());
+  double current = slew_swing_using_angle ? drive_frame.imu : (current_swing == LEFT_SWING ? drive_frame.left : drive_frame.right);
   slew_swing.iterate(current);
 
   // Clip swingPID to max speed
   double swing_out = util::clamp(swingPID.output, slew_swing.output(), -slew_swing.output());
 
   // Clip the speed of the turn when the robot is within StartI, only do this when target is larger then StartI
-  if (swingPID.constants.ki != 0 && (fabs(swingPID.target_get()) > swingPID.constants.start_i && fabs(swingPID.error) < swingPID.constants.start_i)) {
+  // A gain schedule softens the swing near target on its own, so this isn't needed with one
+  if (!swingPID.gain_schedule_enabled() && swingPID.constants.ki != 0 && (fabs(swingPID.target_get()) > swingPID.constants.start_i && fabs(swingPID.error) < swingPID.constants.start_i)) {
     if (pid_swing_min_get() != 0)
       swing_out = util::clamp(swing_out, pid_swing_min_get(), -pid_swing_min_get());
   }
@@ -157,26 +287,28 @@ void Drive::swing_pid_task() {
 
 // Odom To Point Task
 void Drive::ptp_task() {
+  EZ_PROFILE(drive_stage_timers[STAGE_PTP]);
+
   // Compute slew
-  slew_left.iterate(drive_sensor_left());
-  slew_right.iterate(drive_sensor_right());
+  slew_left.iterate(drive_frame.left);
+  slew_right.iterate(drive_frame.right);
   double max_slew_out = fmax(slew_left.output(), slew_right.output());
 
   // Decide if we've past the target or not
-  double temp_target = is_past_target(odom_target, odom_pose_get());        // Use this instead of distance formula to fix impossible movements
-  int dir = (current_drive_direction == REV ? -1 : 1);                      // If we're going backwards, add a -1
-  int flipped = util::sgn(temp_target) != util::sgn(past_target) ? -1 : 1;  // Check if we've flipped directions to what we started
+  double temp_target = is_past_target(odom_target, drive_frame.odom_predicted);  // Use this instead of distance formula to fix impossible movements
+  int dir = (current_drive_direction == REV ? -1 : 1);                           // If we're going backwards, add a -1
+  int flipped = util::sgn(temp_target) != util::sgn(past_target) ? -1 : 1;       // Check if we've flipped directions to what we started
 
   // Compute xy PID
   new_current_fake += xy_delta_fake * ((dir * flipped));  // Create a "current sensor value" for the PID to calculate off of
-  xyPID.compute_error(fabs(temp_target) * dir * flipped, new_current_fake);
+  xyPID.compute_error(fabs(temp_target) * dir * flipped, new_current_fake, drive_frame.time);
 
   // Compute angle
   pose ptf = point_to_face[!ptf1_running];
-  double a_target = util::absolute_angle_to_point(ptf, odom_pose_get());  // Calculate the point for angle to face
+  double a_target = util::absolute_angle_to_point(ptf, drive_frame.odom_predicted);  // Calculate the point for angle to face
   a_target = new_turn_target_compute(a_target, odom_imu_start, current_angle_behavior);
-  double wrapped_a_target = a_target - odom_theta_get();
-  current_a_odomPID.compute_error(wrapped_a_target, odom_theta_get());
+  double wrapped_a_target = a_target - drive_frame.odom_predicted.theta;
+  current_a_odomPID.compute_error(wrapped_a_target, drive_frame.odom_predicted.theta, drive_frame.time);
   // printf("shortest_a_target: %.2f      error: %.2f\n", a_target, wrapped_a_target);
 
   // Prioritize turning by scaling xy_out down
@@ -220,8 +352,8 @@ void Drive::ptp_task() {
     private_drive_set(l_out, r_out);
 
   // This is for wait_until
-  leftPID.compute(drive_sensor_left());
-  rightPID.compute(drive_sensor_right());
+  leftPID.compute(drive_frame.left, drive_frame.time);
+  rightPID.compute(drive_frame.right, drive_frame.time);
 }
 
 void Drive::boomerang_task() {
@@ -231,7 +363,7 @@ void Drive::boomerang_task() {
   // target.theta += current_drive_direction == REV ? 180 : 0;  // Decide if going fwd or rev
   int dir = current_drive_direction == REV ? -1 : 1;
 
-  double h = util::distance_to_point(target, odom_pose_get()) * odom_boomerang_dlead_get();
+  double h = util::distance_to_point(target, drive_frame.odom_predicted) * odom_boomerang_dlead_get();
   double max = max_boomerang_distance;
   h = h > max ? max : h;
   h *= dir;
@@ -239,7 +371,7 @@ void Drive::boomerang_task() {
   pose temp = util::vector_off_point(-h, pp_movements[target_index].target);
   temp.theta = target.theta;
 
-  if (util::distance_to_point(target, odom_pose_get()) < odom_look_ahead_get() / 2.0) {
+  if (util::distance_to_point(target, drive_frame.odom_predicted) < odom_look_ahead_get() / 2.0) {
     temp = target;
   }
 
@@ -254,7 +386,9 @@ void Drive::boomerang_task() {
 }
 
 void Drive::pp_task() {
-  if (fabs(util::distance_to_point(pp_movements[pp_index].target, odom_pose_get())) < odom_look_ahead_get()) {
+  EZ_PROFILE(drive_stage_timers[STAGE_PP]);
+
+  if (fabs(util::distance_to_point(pp_movements[pp_index].target, drive_frame.odom_predicted)) < odom_look_ahead_get()) {
     if (pp_index < pp_movements.size() - 1) {
       pp_index = pp_index >= pp_movements.size() - 1 ? pp_index : pp_index + 1;
       bool slew_on = slew_left.enabled() || slew_right.enabled() ? true : false;
@@ -68,6 +68,7 @@ void Drive::pid_tuner_enable() {
 
 // Disable PID Tuner
 void Drive::pid_tuner_disable() {
+  pid_tuner_autotune_stop();
   pid_tuner_on = false;
   opcontrol_curve_buttons_toggle(last_controller_curve_state);
   if (last_auton_selector_state) {
@@ -209,4 +210,85 @@ void Drive::pid_tuner_iterate() {
     pid_tuner_value_decrease();
     pid_tuner_print();
   }
+
+  // Start / Stop autotuning
+  if (master.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_X))
+    pid_tuner_autotune_start();
+  else if (master.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_B))
+    pid_tuner_autotune_stop();
+
+  autotune_iterate();
+}
+
+// Autotune rule
+void Drive::pid_tuner_autotune_rule_set(e_autotune_rule rule) { autotuner.rule_set(rule); }
+bool Drive::pid_tuner_autotune_running() { return autotuner.state_get() == AUTOTUNE_RUNNING; }
+
+// Sensor the relay oscillates
+double Drive::autotune_sensor() {
+  if (autotune_mode == DRIVE)
+    return (drive_sensor_left() + drive_sensor_right()) / 2.0;
+  return drive_imu_get();
+}
+
+// Start autotuning the selected constants
+void Drive::pid_tuner_autotune_start(double relay_output, double hysteresis) {
+  if (!pid_tuner_on) return;
+
+  autotune_column = column;
+  autotune_mode = used_pid_tuner_pids->at(autotune_column).mode;
+  if (autotune_mode == DISABLE) {
+    printf("%s can't be autotuned!\n", used_pid_tuner_pids->at(autotune_column).name.c_str());
+    return;
+  }
+
+  // Nothing else should be moving the drive
+  drive_mode_set(DISABLE);
+
+  autotuner.loop_time_set(util::DELAY_TIME);
+  autotuner.timeout_set(15000);
+  autotuner.initialize(autotune_sensor(), util::clamp(relay_output, 127.0, 0.0), hysteresis);
+  printf("Autotuning %s...\n", used_pid_tuner_pids->at(autotune_column).name.c_str());
+}
+
+// Stop autotuning without changing constants
+void Drive::pid_tuner_autotune_stop() {
+  if (!pid_tuner_autotune_running()) return;
+  autotuner.stop();
+  private_drive_set(0, 0);
+  printf("Autotuning stopped.\n");
+}
+
+// Run the relay and save constants once it's done
+void Drive::autotune_iterate() {
+  if (!pid_tuner_autotune_running()) return;
+
+  double output = autotuner.iterate(autotune_sensor(), pros::micros());
+
+  // Left swings only move the left side
+  switch (autotune_mode) {
+    case DRIVE:
+      private_drive_set(output, output);
+      break;
+    case SWING:
+      private_drive_set(output, 0);
+      break;
+    default:
+      private_drive_set(output, -output);
+      break;
+  }
+
+  if (autotuner.state_get() == AUTOTUNE_FAILED) {
+    private_drive_set(0, 0);
+    printf("Autotuning failed, try a larger output.\n");
+  } else if (autotuner.state_get() == AUTOTUNE_DONE) {
+    private_drive_set(0, 0);
+    relay_autotuner::Result result = autotuner.result_get();
+    PID::Constants* consts = used_pid_tuner_pids->at(autotune_column).consts;
+    consts->kp = result.kp;
+    consts->ki = result.ki;
+    consts->kd = result.kd;
+    printf("Autotuning done.  Ku: %.3f  Tu: %.3fs  kp: %.3f  ki: %.4f  kd: %.3f\n", result.ultimate_gain, result.ultimate_period, result.kp, result.ki, result.kd);
+    pid_tuner_print();
+  }
 }
@@ -9,33 +9,54 @@ file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 #include "EZ-Template/drive/drive.hpp"
 
-bool Drive::pto_check(pros::Motor check_if_pto) {
-  auto does_exist = std::find(pto_active.begin(), pto_active.end(), check_if_pto.get_port());
-  if (does_exist != pto_active.end())
-    return true;  // Motor is in the list
-  return false;   // Motor isn't in the list
+// Bit for a port in pto_ports, reversed motors use the same bit
+static std::uint32_t pto_port_bit(int port) {
+  port = abs(port);
+  if (port < 1 || port > 32) return 0;
+  return 1u << (port - 1);
+}
+
+bool Drive::pto_check(const pros::Motor& check_if_pto) {
+  return (pto_ports & pto_port_bit(check_if_pto.get_port())) != 0;
+}
+
+// Rebuilds the list of motors the drive gives power to
+void Drive::drive_output_update() {
+  pto_ports = 0;
+  for (auto i : pto_active) pto_ports |= pto_port_bit(i);
+
+  left_output_count = 0;
+  for (auto& i : left_motors) {
+    if (left_output_count < MAX_DRIVE_MOTORS && !pto_check(i)) left_output[left_output_count++] = &i;
+  }
+  right_output_count = 0;
+  for (auto& i : right_motors) {
+    if (right_output_count < MAX_DRIVE_MOTORS && !pto_check(i)) right_output[right_output_count++] = &i;
+  }
 }
 
 void Drive::pto_add(std::vector<pros::Motor> pto_list) {
-  for (auto i : pto_list) {
-    // Return if the motor is already in the list
-    if (pto_check(i)) return;
+  for (const auto& i : pto_list) {
+    // Stop if the motor is already in the list
+    if (pto_check(i)) break;
 
-    // Return if the first index was used (this motor is used for velocity)
+    // Stop if the first index was used (this motor is used for velocity)
     if (i.get_port() == left_motors[0].get_port() || i.get_port() == right_motors[0].get_port()) {
       printf("You cannot PTO the first index!\n");
-      return;
+      break;
     }
 
     pto_active.push_back(i.get_port());
+    pto_ports |= pto_port_bit(i.get_port());
   }
+  drive_output_update();
 }
 
 void Drive::pto_remove(std::vector<pros::Motor> pto_list) {
-  for (auto i : pto_list) {
+  for (auto& i : pto_list) {
     auto does_exist = std::find(pto_active.begin(), pto_active.end(), i.get_port());
-    // Return if the motor isn't in the list
-    if (does_exist == pto_active.end()) return;
+    // Stop if the motor isn't in the list
+    if (does_exist == pto_active.end()) break;
 
     // Find index of motor
     int index = std::distance(pto_active.begin(), does_exist);
@@ -43,6 +64,7 @@ void Drive::pto_remove(std::vector<pros::Motor> pto_list) {
     i.set_brake_mode(CURRENT_BRAKE);  // Set the motor to the brake type of the drive
     i.set_current_limit(CURRENT_MA);  // Set the motor to the mA of the drive
   }
+  drive_output_update();
 }
 
 void Drive::pto_toggle(std::vector<pros::Motor> pto_list, bool toggle) {
@@ -50,4 +72,4 @@ void Drive::pto_toggle(std::vector<pros::Motor> pto_list, bool toggle) {
     pto_add(pto_list);
   else
     pto_remove(pto_list);
-}
\ No newline at end of file
+}
@@ -46,16 +46,26 @@ void Drive::pid_drive_constants_forward_set(double p, double i, double d, double
 void Drive::pid_drive_constants_backward_set(double p, double i, double d, double p_start_i) {
   backward_drivePID.constants_set(p, i, d, p_start_i);
 }
+void Drive::pid_drive_feedforward_set(double ks, double kv, double ka) {
+  leftPID.feedforward_constants_set(ks, kv, ka);
+  rightPID.feedforward_constants_set(ks, kv, ka);
+}
+PID::Feedforward Drive::pid_drive_feedforward_get() { return leftPID.feedforward_constants_get(); }
+void Drive::pid_drive_profile_set(double max_velocity, double max_acceleration) {
+  drive_profile.constants_set(max_velocity, max_acceleration);
+}
 void Drive::pid_heading_constants_set(double p, double i, double d, double p_start_i) {
   headingPID.constants_set(p, i, d, p_start_i);
 }
 void Drive::drive_angle_set(double angle) {
   headingPID.target_set(angle);
   drive_imu_reset(angle);
-  central_pose.theta = angle;
-  l_pose.theta = angle;
-  r_pose.theta = angle;
+
+  std::lock_guard<pros::Mutex> lock(odom_mutex);
+  odom_tracking.fusion_reset();
+  odom_recording_event(ODOM_FRAME_FUSION_RESET);
   was_odom_just_set = true;
+  odom_history_count.store(0, std::memory_order_release);
 }
 void Drive::drive_angle_set(okapi::QAngle p_angle) {
   double angle = p_angle.convert(okapi::degree);  // Convert okapi unit to degree
@@ -79,25 +89,25 @@ PID::Constants Drive::pid_drive_constants_get() {
 /////
 
 // Set pid using global slew
-void Drive::pid_drive_set(double target, int speed) {
+motion_handle Drive::pid_drive_set(double target, int speed) {
   bool slew_on = util::sgn(target) >= 0 ? slew_drive_forward_get() : slew_drive_backward_get();
-  pid_drive_set(target, speed, slew_on);
+  return pid_drive_set(target, speed, slew_on);
 }
 
 // Set drive PID
-void Drive::pid_drive_set(okapi::QLength p_target, int speed, bool slew_on, bool toggle_heading) {
+motion_handle Drive::pid_drive_set(okapi::QLength p_target, int speed, bool slew_on, bool toggle_heading) {
   double target = p_target.convert(okapi::inch);  // Convert okapi unit to inches
-  pid_drive_set(target, speed, slew_on, toggle_heading);
+  return pid_drive_set(target, speed, slew_on, toggle_heading);
 }
 
 // Set drive PID with global slew and okapi units
-void Drive::pid_drive_set(okapi::QLength p_target, int speed) {
+motion_handle Drive::pid_drive_set(okapi::QLength p_target, int speed) {
   double target = p_target.convert(okapi::inch);  // Convert okapi unit to inches
-  pid_drive_set(target, speed);
+  return pid_drive_set(target, speed);
 }
 
 // Set drive PID raw
-void Drive::pid_drive_set(double target, int speed, bool slew_on, bool toggle_heading) {
+motion_handle Drive::pid_drive_set(double target, int speed, bool slew_on, bool toggle_heading) {
   leftPID.timers_reset();
   rightPID.timers_reset();
 
@@ -142,6 +152,8 @@ void Drive::pid_drive_set(double target, int speed, bool slew_on, bool toggle_he
   PID::Constants pid_drive_consts = new_drive_pid->constants_get();
   leftPID.constants_set(pid_drive_consts.kp, pid_drive_consts.ki, pid_drive_consts.kd, pid_drive_consts.start_i);
   rightPID.constants_set(pid_drive_consts.kp, pid_drive_consts.ki, pid_drive_consts.kd, pid_drive_consts.start_i);
+  leftPID.schedule = new_drive_pid->schedule;
+  rightPID.schedule = new_drive_pid->schedule;
   slew_left.constants_set(slew_consts.distance_to_travel, slew_consts.min_speed);
   slew_right.constants_set(slew_consts.distance_to_travel, slew_consts.min_speed);
 
@@ -154,10 +166,16 @@ void Drive::pid_drive_set(double target, int speed, bool slew_on, bool toggle_he
   slew_right.initialize(slew_on, max_speed, r_target_encoder, drive_sensor_right());
   current_slew_on = slew_on;
 
+  // Initialize feedforward profile
+  drive_profile.initialize(leftPID.feedforward_set_check(), target);
+  drive_profile_start = pros::micros();
+
   // Make sure we're using normal PID
   leftPID.exit = internal_leftPID.exit;
   rightPID.exit = internal_rightPID.exit;
 
   // Run task
   drive_mode_set(DRIVE);
+
+  return motion_current();
 }
\ No newline at end of file
@@ -90,19 +90,19 @@ bool Drive::slew_odom_reenabled() { return slew_reenables_when_max_speed_changes
 /////
 // pid_odom_set but it looks like pid_drive_set
 /////
-void Drive::pid_odom_set(okapi::QLength p_target, int speed, bool slew_on) {
+motion_handle Drive::pid_odom_set(okapi::QLength p_target, int speed, bool slew_on) {
   double target = p_target.convert(okapi::inch);
-  pid_odom_set(target, speed, slew_on);
+  return pid_odom_set(target, speed, slew_on);
 }
-void Drive::pid_odom_set(okapi::QLength p_target, int speed) {
+motion_handle Drive::pid_odom_set(okapi::QLength p_target, int speed) {
   double target = p_target.convert(okapi::inch);
-  pid_odom_set(target, speed);
+  return pid_odom_set(target, speed);
 }
-void Drive::pid_odom_set(double target, int speed) {
+motion_handle Drive::pid_odom_set(double target, int speed) {
   bool slew_on = util::sgn(target) >= 0 ? slew_drive_forward_get() : slew_drive_backward_get();
-  pid_odom_set(target, speed, slew_on);
+  return pid_odom_set(target, speed, slew_on);
 }
-void Drive::pid_odom_set(double target, int speed, bool slew_on) {
+motion_handle Drive::pid_odom_set(double target, int speed, bool slew_on) {
   drive_directions fwd_or_rev = util::sgn(target) >= 0 ? fwd : rev;
   pose target_pose = util::vector_off_point(target, {odom_x_get(), odom_y_get(), headingPID.target_get()});
   odom path = {{target_pose.x, target_pose.y}, fwd_or_rev, speed};
@@ -117,92 +117,94 @@ void Drive::pid_odom_set(double target, int speed, bool slew_on) {
   slew_min_when_it_enabled = 0;
   slew_will_enable_later = false;
   raw_pid_odom_pp_set(input_path, slew_on);
+
+  return motion_current();
 }
 
 /////
 // pid_odom_set
 /////
 // No units
-void Drive::pid_odom_set(odom imovement) {
+motion_handle Drive::pid_odom_set(odom imovement) {
   bool slew_on = imovement.drive_direction == fwd ? slew_drive_forward_get() : slew_drive_backward_get();
-  pid_odom_set(imovement, slew_on);
+  return pid_odom_set(imovement, slew_on);
 }
-void Drive::pid_odom_set(odom imovement, bool slew_on) {
+motion_handle Drive::pid_odom_set(odom imovement, bool slew_on) {
   if (imovement.target.theta != ANGLE_NOT_SET)
     pid_odom_boomerang_set(imovement, slew_on);
   else
-    pid_odom_injected_pp_set({imovement}, slew_on);
+    return pid_odom_injected_pp_set({imovement}, slew_on);
 }
-void Drive::pid_odom_set(std::vector<odom> imovements) {
+motion_handle Drive::pid_odom_set(std::vector<odom> imovements) {
   bool slew_on = imovements[0].drive_direction == fwd ? slew_drive_forward_get() : slew_drive_backward_get();
-  pid_odom_set(imovements, slew_on);
+  return pid_odom_set(imovements, slew_on);
 }
-void Drive::pid_odom_set(std::vector<odom> imovements, bool slew_on) {
-  pid_odom_smooth_pp_set(imovements, slew_on);
+motion_handle Drive::pid_odom_set(std::vector<odom> imovements, bool slew_on) {
+  return pid_odom_smooth_pp_set(imovements, slew_on);
 }
 // Units
-void Drive::pid_odom_set(united_odom p_imovement) {
+motion_handle Drive::pid_odom_set(united_odom p_imovement) {
   odom imovement = util::united_odom_to_odom(p_imovement);
-  pid_odom_set(imovement);
+  return pid_odom_set(imovement);
 }
-void Drive::pid_odom_set(united_odom p_imovement, bool slew_on) {
+motion_handle Drive::pid_odom_set(united_odom p_imovement, bool slew_on) {
   odom imovement = util::united_odom_to_odom(p_imovement);
-  pid_odom_set(imovement, slew_on);
+  return pid_odom_set(imovement, slew_on);
 }
-void Drive::pid_odom_set(std::vector<united_odom> p_imovements) {
+motion_handle Drive::pid_odom_set(std::vector<united_odom> p_imovements) {
   std::vector<odom> imovements = util::united_odoms_to_odoms(p_imovements);
-  pid_odom_set(imovements);
+  return pid_odom_set(imovements);
 }
-void Drive::pid_odom_set(std::vector<united_odom> p_imovements, bool slew_on) {
+motion_handle Drive::pid_odom_set(std::vector<united_odom> p_imovements, bool slew_on) {
   std::vector<odom> imovements = util::united_odoms_to_odoms(p_imovements);
-  pid_odom_set(imovements, slew_on);
+  return pid_odom_set(imovements, slew_on);
 }
 
 /////
 // ptp
 /////
 // No units
-void Drive::pid_odom_ptp_set(odom imovement) {
+motion_handle Drive::pid_odom_ptp_set(odom imovement) {
   bool slew_on = imovement.drive_direction == fwd ? slew_drive_forward_get() : slew_drive_backward_get();
-  pid_odom_ptp_set(imovement, slew_on);
+  return pid_odom_ptp_set(imovement, slew_on);
 }
 // Units
-void Drive::pid_odom_ptp_set(united_odom p_imovement) {
+motion_handle Drive::pid_odom_ptp_set(united_odom p_imovement) {
   odom imovement = util::united_odom_to_odom(p_imovement);
-  pid_odom_ptp_set(imovement);
+  return pid_odom_ptp_set(imovement);
 }
-void Drive::pid_odom_ptp_set(united_odom p_imovement, bool slew_on) {
+motion_handle Drive::pid_odom_ptp_set(united_odom p_imovement, bool slew_on) {
   odom imovement = util::united_odom_to_odom(p_imovement);
-  pid_odom_ptp_set(imovement, slew_on);
+  return pid_odom_ptp_set(imovement, slew_on);
 }
 
 /////
 // pp
 /////
 // No units
-void Drive::pid_odom_pp_set(std::vector<odom> imovements) {
+motion_handle Drive::pid_odom_pp_set(std::vector<odom> imovements) {
   bool slew_on = imovements[0].drive_direction == fwd ? slew_drive_forward_get() : slew_drive_backward_get();
-  pid_odom_pp_set(imovements, slew_on);
+  return pid_odom_pp_set(imovements, slew_on);
 }
 // Units
-void Drive::pid_odom_pp_set(std::vector<united_odom> p_imovements) {
+motion_handle Drive::pid_odom_pp_set(std::vector<united_odom> p_imovements) {
   std::vector<odom> imovements = util::united_odoms_to_odoms(p_imovements);
-  pid_odom_pp_set(imovements);
+  return pid_odom_pp_set(imovements);
 }
-void Drive::pid_odom_pp_set(std::vector<united_odom> p_imovements, bool slew_on) {
+motion_handle Drive::pid_odom_pp_set(std::vector<united_odom> p_imovements, bool slew_on) {
   std::vector<odom> imovements = util::united_odoms_to_odoms(p_imovements);
-  pid_odom_pp_set(imovements, slew_on);
+  return pid_odom_pp_set(imovements, slew_on);
 }
 
 /////
 // injected pp
 /////
 // No units
-void Drive::pid_odom_injected_pp_set(std::vector<ez::odom> imovements) {
+motion_handle Drive::pid_odom_injected_pp_set(std::vector<ez::odom> imovements) {
   bool slew_on = imovements[0].drive_direction == fwd ? slew_drive_forward_get() : slew_drive_backward_get();
-  pid_odom_injected_pp_set(imovements, slew_on);
+  return pid_odom_injected_pp_set(imovements, slew_on);
 }
-void Drive::pid_odom_injected_pp_set(std::vector<ez::odom> imovements, bool slew_on) {
+motion_handle Drive::pid_odom_injected_pp_set(std::vector<ez::odom> imovements, bool slew_on) {
   xyPID.timers_reset();
   current_a_odomPID.timers_reset();
 
@@ -213,26 +215,28 @@ void Drive::pid_odom_injected_pp_set(std::vector<ez::odom> imovements, bool slew
   slew_min_when_it_enabled = 0;
   slew_will_enable_later = false;
   raw_pid_odom_pp_set(input_path, slew_on);
+
+  return motion_current();
 }
 // Units
-void Drive::pid_odom_injected_pp_set(std::vector<ez::united_odom> p_imovements) {
+motion_handle Drive::pid_odom_injected_pp_set(std::vector<ez::united_odom> p_imovements) {
   std::vector<odom> imovements = util::united_odoms_to_odoms(p_imovements);
-  pid_odom_injected_pp_set(imovements);
+  return pid_odom_injected_pp_set(imovements);
 }
-void Drive::pid_odom_injected_pp_set(std::vector<ez::united_odom> p_imovements, bool slew_on) {
+motion_handle Drive::pid_odom_injected_pp_set(std::vector<ez::united_odom> p_imovements, bool slew_on) {
   std::vector<odom> imovements = util::united_odoms_to_odoms(p_imovements);
-  pid_odom_injected_pp_set(imovements, slew_on);
+  return pid_odom_injected_pp_set(imovements, slew_on);
 }
 
 /////
 // smooth injected pp
 /////
 // No units
-void Drive::pid_odom_smooth_pp_set(std::vector<odom> imovements) {
+motion_handle Drive::pid_odom_smooth_pp_set(std::vector<odom> imovements) {
   bool slew_on = imovements[0].drive_direction == fwd ? slew_drive_forward_get() : slew_drive_backward_get();
-  pid_odom_smooth_pp_set(imovements, slew_on);
+  return pid_odom_smooth_pp_set(imovements, slew_on);
 }
-void Drive::pid_odom_smooth_pp_set(std::vector<odom> imovements, bool slew_on) {
+motion_handle Drive::pid_odom_smooth_pp_set(std::vector<odom> imovements, bool slew_on) {
   xyPID.timers_reset();
   current_a_odomPID.timers_reset();
 
@@ -243,43 +247,45 @@ void Drive::pid_odom_smooth_pp_set(std::vector<odom> imovements, bool slew_on) {
   slew_min_when_it_enabled = 0;
   slew_will_enable_later = false;
   raw_pid_odom_pp_set(input_path, slew_on);
+
+  return motion_current();
 }
 // Units
-void Drive::pid_odom_smooth_pp_set(std::vector<united_odom> p_imovements) {
+motion_handle Drive::pid_odom_smooth_pp_set(std::vector<united_odom> p_imovements) {
   std::vector<odom> imovements = util::united_odoms_to_odoms(p_imovements);
-  pid_odom_smooth_pp_set(imovements);
+  return pid_odom_smooth_pp_set(imovements);
 }
-void Drive::pid_odom_smooth_pp_set(std::vector<united_odom> p_imovements, bool slew_on) {
+motion_handle Drive::pid_odom_smooth_pp_set(std::vector<united_odom> p_imovements, bool slew_on) {
   std::vector<odom> imovements = util::united_odoms_to_odoms(p_imovements);
-  pid_odom_smooth_pp_set(imovements, slew_on);
+  return pid_odom_smooth_pp_set(imovements, slew_on);
 }
 
 /////
 // boomerang
 /////
 // No units
-void Drive::pid_odom_boomerang_set(odom imovement) {
+motion_handle Drive::pid_odom_boomerang_set(odom imovement) {
   bool slew_on = imovement.drive_direction == fwd ? slew_drive_forward_get() : slew_drive_backward_get();
-  pid_odom_boomerang_set(imovement, slew_on);
+  return pid_odom_boomerang_set(imovement, slew_on);
 }
-void Drive::pid_odom_boomerang_set(odom imovement, bool slew_on) {
+motion_handle Drive::pid_odom_boomerang_set(odom imovement, bool slew_on) {
   if (print_toggle) printf("Boomerang ");
-  pid_odom_pp_set({imovement}, slew_on);
+  return pid_odom_pp_set({imovement}, slew_on);
 }
 // Units
-void Drive::pid_odom_boomerang_set(united_odom p_imovement) {
+motion_handle Drive::pid_odom_boomerang_set(united_odom p_imovement) {
   odom imovement = util::united_odom_to_odom(p_imovement);
-  pid_odom_boomerang_set(imovement);
+  return pid_odom_boomerang_set(imovement);
 }
-void Drive::pid_odom_boomerang_set(united_odom p_imovement, bool slew_on) {
+motion_handle Drive::pid_odom_boomerang_set(united_odom p_imovement, bool slew_on) {
   odom imovement = util::united_odom_to_odom(p_imovement);
-  pid_odom_boomerang_set(imovement, slew_on);
+  return pid_odom_boomerang_set(imovement, slew_on);
 }
 
 /////
 // External base pure pursuit
 /////
-void Drive::pid_odom_pp_set(std::vector<odom> imovements, bool slew_on) {
+motion_handle Drive::pid_odom_pp_set(std::vector<odom> imovements, bool slew_on) {
   xyPID.timers_reset();
   current_a_odomPID.timers_reset();
 
@@ -325,12 +331,14 @@ void Drive::pid_odom_pp_set(std::vector<odom> imovements, bool slew_on) {
 
   if (print_toggle) printf("Pure Pursuit ");
   raw_pid_odom_pp_set(input, slew_on);
+
+  return motion_current();
 }
 
 //////
 // External base ptp
 /////
-void Drive::pid_odom_ptp_set(odom imovement, bool slew_on) {
+motion_handle Drive::pid_odom_ptp_set(odom imovement, bool slew_on) {
   imovement = set_odom_direction(imovement);
 
   odom_second_to_last = odom_pose_get();
@@ -357,6 +365,8 @@ void Drive::pid_odom_ptp_set(odom imovement, bool slew_on) {
   slew_right.initialize(slew_on, max_speed, dist_to_target + r_start, r_start);
 
   drive_mode_set(POINT_TO_POINT);
+
+  return motion_current();
 }
 
 /////
@@ -435,6 +445,7 @@ void Drive::raw_pid_odom_ptp_set(odom imovement, bool slew_on) {
   // Set constants
   PID::Constants pid_drive_consts = new_drive_pid->constants_get();
   xyPID.constants_set(pid_drive_consts.kp, pid_drive_consts.ki, pid_drive_consts.kd, pid_drive_consts.start_i);
+  xyPID.schedule = new_drive_pid->schedule;
 
   // Set max speed
   pid_speed_max_set(imovement.max_xy_speed);
@@ -61,7 +61,25 @@ void Drive::pid_targets_reset() {
 }
 
 void Drive::drive_mode_set(e_mode p_mode, bool stop_drive) {
+  bool was_disabled = mode == DISABLE;
+
+  // Driver control disables the drive every loop, that only ends a motion once.
+  // The id goes up before the mode changes so the autonomous task never sees the new mode with the old id
+  bool new_motion = !(was_disabled && p_mode == DISABLE);
+  if (new_motion) motion_start(p_mode);
   mode = p_mode;
+  exits_rearm();  // Anything waiting on the last motion stops waiting
+
+  // The tasks set these every loop while a profile is running
+  leftPID.reference_set(0.0, 0.0);
+  rightPID.reference_set(0.0, 0.0);
+  turnPID.reference_set(0.0, 0.0);
+  leftPID.reference_position_clear();
+  rightPID.reference_position_clear();
+  turnPID.reference_position_clear();
+
+  // Motions started from anywhere but the motion queue replace the queue
+  if (new_motion && pros::c::task_get_current() != (pros::task_t)ez_auto) motion_queue_clear();
   if (mode == DISABLE && stop_drive)
     private_drive_set(0, 0);
 }
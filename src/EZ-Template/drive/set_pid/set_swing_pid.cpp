@@ -92,188 +92,188 @@ ez::e_angle_behavior Drive::pid_swing_behavior_get() { return default_swing_type
 // Set swing PID basic wrappers
 /////
 // Absolute
-void Drive::pid_swing_set(e_swing type, double target, int speed) {
+motion_handle Drive::pid_swing_set(e_swing type, double target, int speed) {
   bool slew_on = is_swing_slew_enabled(type, target, drive_imu_get());
-  pid_swing_set(type, target, speed, 0, pid_swing_behavior_get(), slew_on);
+  return pid_swing_set(type, target, speed, 0, pid_swing_behavior_get(), slew_on);
 }
-void Drive::pid_swing_set(e_swing type, okapi::QAngle p_target, int speed) {
+motion_handle Drive::pid_swing_set(e_swing type, okapi::QAngle p_target, int speed) {
   double target = p_target.convert(okapi::degree);  // Convert okapi unit to degree
-  pid_swing_set(type, target, speed);
+  return pid_swing_set(type, target, speed);
 }
 // Relative
-void Drive::pid_swing_relative_set(e_swing type, double target, int speed) {
+motion_handle Drive::pid_swing_relative_set(e_swing type, double target, int speed) {
   // Figure out if going forward or backward
   double absolute_heading = target + headingPID.target_get();
   bool slew_on = is_swing_slew_enabled(type, absolute_heading, drive_imu_get());
-  pid_swing_relative_set(type, target, speed, 0, pid_swing_behavior_get(), slew_on);
+  return pid_swing_relative_set(type, target, speed, 0, pid_swing_behavior_get(), slew_on);
 }
-void Drive::pid_swing_relative_set(e_swing type, okapi::QAngle p_target, int speed) {
+motion_handle Drive::pid_swing_relative_set(e_swing type, okapi::QAngle p_target, int speed) {
   double target = p_target.convert(okapi::degree);  // Convert okapi unit to degree
-  pid_swing_relative_set(type, target, speed);
+  return pid_swing_relative_set(type, target, speed);
 }
 
 /////
 // Set turn PID with only swing behavior
 /////
 // Absolute
-void Drive::pid_swing_set(e_swing type, double target, int speed, e_angle_behavior behavior) {
+motion_handle Drive::pid_swing_set(e_swing type, double target, int speed, e_angle_behavior behavior) {
   bool slew_on = is_swing_slew_enabled(type, target, drive_imu_get());
-  pid_swing_set(type, target, speed, 0, behavior, slew_on);
+  return pid_swing_set(type, target, speed, 0, behavior, slew_on);
 }
-void Drive::pid_swing_set(e_swing type, okapi::QAngle p_target, int speed, e_angle_behavior behavior) {
+motion_handle Drive::pid_swing_set(e_swing type, okapi::QAngle p_target, int speed, e_angle_behavior behavior) {
   double target = p_target.convert(okapi::degree);  // Convert okapi unit to degree
-  pid_swing_set(type, target, speed, behavior);
+  return pid_swing_set(type, target, speed, behavior);
 }
 // Relative
-void Drive::pid_swing_relative_set(e_swing type, double target, int speed, e_angle_behavior behavior) {
+motion_handle Drive::pid_swing_relative_set(e_swing type, double target, int speed, e_angle_behavior behavior) {
   // Figure out if going forward or backward
   double absolute_heading = target + headingPID.target_get();
   bool slew_on = is_swing_slew_enabled(type, absolute_heading, drive_imu_get());
-  pid_swing_relative_set(type, target, speed, 0, behavior, slew_on);
+  return pid_swing_relative_set(type, target, speed, 0, behavior, slew_on);
 }
-void Drive::pid_swing_relative_set(e_swing type, okapi::QAngle p_target, int speed, e_angle_behavior behavior) {
+motion_handle Drive::pid_swing_relative_set(e_swing type, okapi::QAngle p_target, int speed, e_angle_behavior behavior) {
   double target = p_target.convert(okapi::degree);  // Convert okapi unit to degree
-  pid_swing_relative_set(type, target, speed, behavior);
+  return pid_swing_relative_set(type, target, speed, behavior);
 }
 
 /////
 // Set turn PID with only opposite speed
 /////
 // Absolute
-void Drive::pid_swing_set(e_swing type, double target, int speed, int opposite_speed) {
+motion_handle Drive::pid_swing_set(e_swing type, double target, int speed, int opposite_speed) {
   bool slew_on = is_swing_slew_enabled(type, target, drive_imu_get());
-  pid_swing_set(type, target, speed, opposite_speed, pid_swing_behavior_get(), slew_on);
+  return pid_swing_set(type, target, speed, opposite_speed, pid_swing_behavior_get(), slew_on);
 }
-void Drive::pid_swing_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed) {
+motion_handle Drive::pid_swing_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed) {
   double target = p_target.convert(okapi::degree);  // Convert okapi unit to degree
   bool slew_on = is_swing_slew_enabled(type, target, drive_imu_get());
-  pid_swing_set(type, target, speed, opposite_speed, slew_on);
+  return pid_swing_set(type, target, speed, opposite_speed, slew_on);
 }
 // Relative
-void Drive::pid_swing_relative_set(e_swing type, double target, int speed, int opposite_speed) {
+motion_handle Drive::pid_swing_relative_set(e_swing type, double target, int speed, int opposite_speed) {
   double absolute_heading = target + headingPID.target_get();
   bool slew_on = is_swing_slew_enabled(type, absolute_heading, drive_imu_get());
-  pid_swing_relative_set(type, target, speed, opposite_speed, pid_swing_behavior_get(), slew_on);
+  return pid_swing_relative_set(type, target, speed, opposite_speed, pid_swing_behavior_get(), slew_on);
 }
-void Drive::pid_swing_relative_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed) {
+motion_handle Drive::pid_swing_relative_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed) {
   double target = p_target.convert(okapi::degree);  // Convert okapi unit to degree
-  pid_swing_relative_set(type, target, speed, opposite_speed);
+  return pid_swing_relative_set(type, target, speed, opposite_speed);
 }
 
 /////
 // Set turn PID with only slew
 /////
 // Absolute
-void Drive::pid_swing_set(e_swing type, double target, int speed, bool slew_on) {
-  pid_swing_set(type, target, speed, 0, pid_swing_behavior_get(), slew_on);
+motion_handle Drive::pid_swing_set(e_swing type, double target, int speed, bool slew_on) {
+  return pid_swing_set(type, target, speed, 0, pid_swing_behavior_get(), slew_on);
 }
-void Drive::pid_swing_set(e_swing type, okapi::QAngle p_target, int speed, bool slew_on) {
+motion_handle Drive::pid_swing_set(e_swing type, okapi::QAngle p_target, int speed, bool slew_on) {
   double target = p_target.convert(okapi::degree);  // Convert okapi unit to degree
-  pid_swing_set(type, target, speed, slew_on);
+  return pid_swing_set(type, target, speed, slew_on);
 }
 // Relative
-void Drive::pid_swing_relative_set(e_swing type, double target, int speed, bool slew_on) {
-  pid_swing_relative_set(type, target, speed, 0, pid_swing_behavior_get(), slew_on);
+motion_handle Drive::pid_swing_relative_set(e_swing type, double target, int speed, bool slew_on) {
+  return pid_swing_relative_set(type, target, speed, 0, pid_swing_behavior_get(), slew_on);
 }
-void Drive::pid_swing_relative_set(e_swing type, okapi::QAngle p_target, int speed, bool slew_on) {
+motion_handle Drive::pid_swing_relative_set(e_swing type, okapi::QAngle p_target, int speed, bool slew_on) {
   double target = p_target.convert(okapi::degree);  // Convert okapi unit to degree
-  pid_swing_relative_set(type, target, speed, slew_on);
+  return pid_swing_relative_set(type, target, speed, slew_on);
 }
 
 /////
 // Set turn PID with only opposite speed and swing behavior
 /////
 // Absolute
-void Drive::pid_swing_set(e_swing type, double target, int speed, int opposite_speed, e_angle_behavior behavior) {
+motion_handle Drive::pid_swing_set(e_swing type, double target, int speed, int opposite_speed, e_angle_behavior behavior) {
   bool slew_on = is_swing_slew_enabled(type, target, drive_imu_get());
-  pid_swing_set(type, target, speed, opposite_speed, behavior, slew_on);
+  return pid_swing_set(type, target, speed, opposite_speed, behavior, slew_on);
 }
-void Drive::pid_swing_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed, e_angle_behavior behavior) {
+motion_handle Drive::pid_swing_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed, e_angle_behavior behavior) {
   double target = p_target.convert(okapi::degree);  // Convert okapi unit to degree
   bool slew_on = is_swing_slew_enabled(type, target, drive_imu_get());
-  pid_swing_set(type, target, speed, opposite_speed, behavior);
+  return pid_swing_set(type, target, speed, opposite_speed, behavior);
 }
 // Relative
-void Drive::pid_swing_relative_set(e_swing type, double target, int speed, int opposite_speed, e_angle_behavior behavior) {
+motion_handle Drive::pid_swing_relative_set(e_swing type, double target, int speed, int opposite_speed, e_angle_behavior behavior) {
   double absolute_heading = target + headingPID.target_get();
   bool slew_on = is_swing_slew_enabled(type, absolute_heading, drive_imu_get());
-  pid_swing_relative_set(type, target, speed, opposite_speed, behavior, slew_on);
+  return pid_swing_relative_set(type, target, speed, opposite_speed, behavior, slew_on);
 }
-void Drive::pid_swing_relative_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed, e_angle_behavior behavior) {
+motion_handle Drive::pid_swing_relative_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed, e_angle_behavior behavior) {
   double target = p_target.convert(okapi::degree);  // Convert okapi unit to degree
-  pid_swing_relative_set(type, target, speed, opposite_speed, behavior);
+  return pid_swing_relative_set(type, target, speed, opposite_speed, behavior);
 }
 
 /////
 // Set turn PID with opposite speed and slew
 /////
 // Absolute
-void Drive::pid_swing_set(e_swing type, double target, int speed, int opposite_speed, bool slew_on) {
-  pid_swing_set(type, target, speed, opposite_speed, pid_swing_behavior_get(), slew_on);
+motion_handle Drive::pid_swing_set(e_swing type, double target, int speed, int opposite_speed, bool slew_on) {
+  return pid_swing_set(type, target, speed, opposite_speed, pid_swing_behavior_get(), slew_on);
 }
-void Drive::pid_swing_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed, bool slew_on) {
+motion_handle Drive::pid_swing_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed, bool slew_on) {
   double target = p_target.convert(okapi::degree);  // Convert okapi unit to degree
-  pid_swing_set(type, target, speed, opposite_speed, slew_on);
+  return pid_swing_set(type, target, speed, opposite_speed, slew_on);
 }
 // Relative
-void Drive::pid_swing_relative_set(e_swing type, double target, int speed, int opposite_speed, bool slew_on) {
+motion_handle Drive::pid_swing_relative_set(e_swing type, double target, int speed, int opposite_speed, bool slew_on) {
   // Compute absolute target by adding to current heading
   double absolute_target = headingPID.target_get() + target;
   if (print_toggle) printf("Relative ");
-  pid_swing_set(type, absolute_target, speed, opposite_speed, pid_swing_behavior_get(), slew_on);
+  return pid_swing_set(type, absolute_target, speed, opposite_speed, pid_swing_behavior_get(), slew_on);
 }
-void Drive::pid_swing_relative_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed, bool slew_on) {
+motion_handle Drive::pid_swing_relative_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed, bool slew_on) {
   double target = p_target.convert(okapi::degree);  // Convert okapi unit to degree
-  pid_swing_relative_set(type, target, speed, opposite_speed, slew_on);
+  return pid_swing_relative_set(type, target, speed, opposite_speed, slew_on);
 }
 
 /////
 // Set turn PID with swing behavior and slew
 /////
 // Absolute
-void Drive::pid_swing_set(e_swing type, double target, int speed, e_angle_behavior behavior, bool slew_on) {
-  pid_swing_set(type, target, speed, 0, pid_swing_behavior_get(), slew_on);
+motion_handle Drive::pid_swing_set(e_swing type, double target, int speed, e_angle_behavior behavior, bool slew_on) {
+  return pid_swing_set(type, target, speed, 0, pid_swing_behavior_get(), slew_on);
 }
-void Drive::pid_swing_set(e_swing type, okapi::QAngle p_target, int speed, e_angle_behavior behavior, bool slew_on) {
+motion_handle Drive::pid_swing_set(e_swing type, okapi::QAngle p_target, int speed, e_angle_behavior behavior, bool slew_on) {
   double target = p_target.convert(okapi::degree);  // Convert okapi unit to degree
-  pid_swing_set(type, target, speed, behavior, slew_on);
+  return pid_swing_set(type, target, speed, behavior, slew_on);
 }
 // Relative
-void Drive::pid_swing_relative_set(e_swing type, double target, int speed, e_angle_behavior behavior, bool slew_on) {
+motion_handle Drive::pid_swing_relative_set(e_swing type, double target, int speed, e_angle_behavior behavior, bool slew_on) {
   // Compute absolute target by adding to current heading
   double absolute_target = headingPID.target_get() + target;
   if (print_toggle) printf("Relative ");
-  pid_swing_set(type, absolute_target, speed, 0, pid_swing_behavior_get(), slew_on);
+  return pid_swing_set(type, absolute_target, speed, 0, pid_swing_behavior_get(), slew_on);
 }
-void Drive::pid_swing_relative_set(e_swing type, okapi::QAngle p_target, int speed, e_angle_behavior behavior, bool slew_on) {
+motion_handle Drive::pid_swing_relative_set(e_swing type, okapi::QAngle p_target, int speed, e_angle_behavior behavior, bool slew_on) {
   double target = p_target.convert(okapi::degree);  // Convert okapi unit to degree
-  pid_swing_relative_set(type, target, speed, behavior, slew_on);
+  return pid_swing_relative_set(type, target, speed, behavior, slew_on);
 }
 
 /////
 // Set turn PID with opposite speed, swing behavior, and slew
 /////
 // Absolute
-void Drive::pid_swing_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed, e_angle_behavior behavior, bool slew_on) {
+motion_handle Drive::pid_swing_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed, e_angle_behavior behavior, bool slew_on) {
   double target = p_target.convert(okapi::degree);  // Convert okapi unit to degree
-  pid_swing_set(type, target, speed, opposite_speed, behavior, slew_on);
+  return pid_swing_set(type, target, speed, opposite_speed, behavior, slew_on);
 }
 // Relative
-void Drive::pid_swing_relative_set(e_swing type, double target, int speed, int opposite_speed, e_angle_behavior behavior, bool slew_on) {
+motion_handle Drive::pid_swing_relative_set(e_swing type, double target, int speed, int opposite_speed, e_angle_behavior behavior, bool slew_on) {
   // Compute absolute target by adding to current heading
   double absolute_target = headingPID.target_get() + target;
   if (print_toggle) printf("Relative ");
-  pid_swing_set(type, absolute_target, speed, opposite_speed, behavior, slew_on);
+  return pid_swing_set(type, absolute_target, speed, opposite_speed, behavior, slew_on);
 }
-void Drive::pid_swing_relative_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed, e_angle_behavior behavior, bool slew_on) {
+motion_handle Drive::pid_swing_relative_set(e_swing type, okapi::QAngle p_target, int speed, int opposite_speed, e_angle_behavior behavior, bool slew_on) {
   double target = p_target.convert(okapi::degree);  // Convert okapi unit to degree
-  pid_swing_relative_set(type, target, speed, opposite_speed, behavior, slew_on);
+  return pid_swing_relative_set(type, target, speed, opposite_speed, behavior, slew_on);
 }
 
 /////
 // Swing set base
 /////
-void Drive::pid_swing_set(e_swing type, double target, int speed, int opposite_speed, e_angle_behavior behavior, bool slew_on) {
+motion_handle Drive::pid_swing_set(e_swing type, double target, int speed, int opposite_speed, e_angle_behavior behavior, bool slew_on) {
   swingPID.timers_reset();
 
   // Set turn behavior
@@ -328,8 +328,11 @@ void Drive::pid_swing_set(e_swing type, double target, int speed, int opposite_s
   PID::Constants pid_drive_consts = new_drive_pid->constants_get();
   PID::Constants pid_swing_consts = new_swing_pid->constants_get();
   swingPID.constants_set(pid_swing_consts.kp, pid_swing_consts.ki, pid_swing_consts.kd, pid_swing_consts.start_i);
+  swingPID.schedule = new_swing_pid->schedule;
   leftPID.constants_set(pid_drive_consts.kp, pid_drive_consts.ki, pid_drive_consts.kd, pid_drive_consts.start_i);
   rightPID.constants_set(pid_drive_consts.kp, pid_drive_consts.ki, pid_drive_consts.kd, pid_drive_consts.start_i);
+  leftPID.schedule = new_drive_pid->schedule;
+  rightPID.schedule = new_drive_pid->schedule;
   slew_swing.constants_set(slew_consts.distance_to_travel, slew_consts.min_speed);
 
   // Set targets for the side that isn't moving
@@ -351,4 +354,6 @@ void Drive::pid_swing_set(e_swing type, double target, int speed, int opposite_s
 
   // Run task
   drive_mode_set(SWING);
+
+  return motion_current();
 }
@@ -18,6 +18,11 @@ void Drive::pid_turn_constants_set(double p, double i, double d, double p_start_
   turnPID.constants_set(p, i, d, p_start_i);
 }
 PID::Constants Drive::pid_turn_constants_get() { return turnPID.constants_get(); }
+void Drive::pid_turn_feedforward_set(double ks, double kv, double ka) { turnPID.feedforward_constants_set(ks, kv, ka); }
+PID::Feedforward Drive::pid_turn_feedforward_get() { return turnPID.feedforward_constants_get(); }
+void Drive::pid_turn_profile_set(double max_velocity, double max_acceleration) {
+  turn_profile.constants_set(max_velocity, max_acceleration);
+}
 void Drive::pid_turn_min_set(int min) { turn_min = abs(min); }
 int Drive::pid_turn_min_get() { return turn_min; }
 
@@ -40,82 +45,82 @@ double Drive::flip_angle_target(double target) {
 // Set turn PID basic wrappers
 /////
 // Absolute
-void Drive::pid_turn_set(double target, int speed) {
-  pid_turn_set(target, speed, pid_turn_behavior_get(), slew_turn_get());
+motion_handle Drive::pid_turn_set(double target, int speed) {
+  return pid_turn_set(target, speed, pid_turn_behavior_get(), slew_turn_get());
 }
-void Drive::pid_turn_set(okapi::QAngle p_target, int speed) {
-  pid_turn_set(p_target, speed, pid_turn_behavior_get(), slew_turn_get());
+motion_handle Drive::pid_turn_set(okapi::QAngle p_target, int speed) {
+  return pid_turn_set(p_target, speed, pid_turn_behavior_get(), slew_turn_get());
 }
 // Relative
-void Drive::pid_turn_relative_set(double target, int speed) {
-  pid_turn_relative_set(target, speed, pid_turn_behavior_get(), slew_turn_get());
+motion_handle Drive::pid_turn_relative_set(double target, int speed) {
+  return pid_turn_relative_set(target, speed, pid_turn_behavior_get(), slew_turn_get());
 }
-void Drive::pid_turn_relative_set(okapi::QAngle p_target, int speed) {
-  pid_turn_relative_set(p_target, speed, pid_turn_behavior_get(), slew_turn_get());
+motion_handle Drive::pid_turn_relative_set(okapi::QAngle p_target, int speed) {
+  return pid_turn_relative_set(p_target, speed, pid_turn_behavior_get(), slew_turn_get());
 }
 
 /////
 // Set turn PID with only turn behavior
 /////
 // Absolute
-void Drive::pid_turn_set(double target, int speed, e_angle_behavior behavior) {
-  pid_turn_set(target, speed, behavior, slew_turn_get());
+motion_handle Drive::pid_turn_set(double target, int speed, e_angle_behavior behavior) {
+  return pid_turn_set(target, speed, behavior, slew_turn_get());
 }
-void Drive::pid_turn_set(okapi::QAngle p_target, int speed, e_angle_behavior behavior) {
-  pid_turn_set(p_target, speed, behavior, slew_turn_get());
+motion_handle Drive::pid_turn_set(okapi::QAngle p_target, int speed, e_angle_behavior behavior) {
+  return pid_turn_set(p_target, speed, behavior, slew_turn_get());
 }
 // Relative
-void Drive::pid_turn_relative_set(okapi::QAngle p_target, int speed, e_angle_behavior behavior) {
-  pid_turn_relative_set(p_target, speed, behavior, slew_turn_get());
+motion_handle Drive::pid_turn_relative_set(okapi::QAngle p_target, int speed, e_angle_behavior behavior) {
+  return pid_turn_relative_set(p_target, speed, behavior, slew_turn_get());
 }
-void Drive::pid_turn_relative_set(double target, int speed, e_angle_behavior behavior) {
-  pid_turn_relative_set(target, speed, behavior, slew_turn_get());
+motion_handle Drive::pid_turn_relative_set(double target, int speed, e_angle_behavior behavior) {
+  return pid_turn_relative_set(target, speed, behavior, slew_turn_get());
 }
 
 /////
 // Set turn PID with only slew
 /////
 // Absolute
-void Drive::pid_turn_set(double target, int speed, bool slew_on) {
-  pid_turn_set(target, speed, pid_turn_behavior_get(), slew_on);
+motion_handle Drive::pid_turn_set(double target, int speed, bool slew_on) {
+  return pid_turn_set(target, speed, pid_turn_behavior_get(), slew_on);
 }
-void Drive::pid_turn_set(okapi::QAngle p_target, int speed, bool slew_on) {
+motion_handle Drive::pid_turn_set(okapi::QAngle p_target, int speed, bool slew_on) {
   double target = p_target.convert(okapi::degree);  // Convert okapi unit to degree
-  pid_turn_set(target, speed, pid_turn_behavior_get(), slew_on);
+  return pid_turn_set(target, speed, pid_turn_behavior_get(), slew_on);
 }
 // Relative
-void Drive::pid_turn_relative_set(double target, int speed, bool slew_on) {
-  pid_turn_relative_set(target, speed, pid_turn_behavior_get(), slew_on);
+motion_handle Drive::pid_turn_relative_set(double target, int speed, bool slew_on) {
+  return pid_turn_relative_set(target, speed, pid_turn_behavior_get(), slew_on);
 }
-void Drive::pid_turn_relative_set(okapi::QAngle p_target, int speed, bool slew_on) {
+motion_handle Drive::pid_turn_relative_set(okapi::QAngle p_target, int speed, bool slew_on) {
   double target = p_target.convert(okapi::degree);  // Convert okapi unit to degree
-  pid_turn_relative_set(target, speed, pid_turn_behavior_get(), slew_on);
+  return pid_turn_relative_set(target, speed, pid_turn_behavior_get(), slew_on);
 }
 
 /////
 // Set turn PID with turn behavior and slew
 /////
 // Absolute
-void Drive::pid_turn_set(okapi::QAngle p_target, int speed, e_angle_behavior behavior, bool slew_on) {
+motion_handle Drive::pid_turn_set(okapi::QAngle p_target, int speed, e_angle_behavior behavior, bool slew_on) {
   double target = p_target.convert(okapi::degree);  // Convert okapi unit to degree
-  pid_turn_set(target, speed, behavior, slew_on);
+  return pid_turn_set(target, speed, behavior, slew_on);
 }
 // Relative
-void Drive::pid_turn_relative_set(double target, int speed, e_angle_behavior behavior, bool slew_on) {
+motion_handle Drive::pid_turn_relative_set(double target, int speed, e_angle_behavior behavior, bool slew_on) {
   // Compute absolute target by adding to current heading
   double absolute_target = headingPID.target_get() + target;
   if (print_toggle) printf("Relative ");
-  pid_turn_set(absolute_target, speed, behavior, slew_on);
+  return pid_turn_set(absolute_target, speed, behavior, slew_on);
 }
-void Drive::pid_turn_relative_set(okapi::QAngle p_target, int speed, e_angle_behavior behavior, bool slew_on) {
+motion_handle Drive::pid_turn_relative_set(okapi::QAngle p_target, int speed, e_angle_behavior behavior, bool slew_on) {
   double target = p_target.convert(okapi::degree);  // Convert okapi unit to degree
-  pid_turn_relative_set(target, speed, behavior, slew_on);
+  return pid_turn_relative_set(target, speed, behavior, slew_on);
 }
 
 /////
 // Turn to angle base
 /////
-void Drive::pid_turn_set(double target, int speed, e_angle_behavior behavior, bool slew_on) {
+motion_handle Drive::pid_turn_set(double target, int speed, e_angle_behavior behavior, bool slew_on) {
   turnPID.timers_reset();
 
   // Set turn behavior
@@ -140,41 +145,47 @@ void Drive::pid_turn_set(double target, int speed, e_angle_behavior behavior, bo
   slew_turn.initialize(slew_on, max_speed, target, chain_sensor_start);
   current_slew_on = slew_on;
 
+  // Initialize feedforward profile
+  turn_profile.initialize(turnPID.feedforward_set_check(), target - chain_sensor_start);
+  turn_profile_start = pros::micros();
+
   // Run task
   drive_mode_set(TURN);
+
+  return motion_current();
 }
 
 /////
 // Turn to point wrappers
 /////
 // No units
-void Drive::pid_turn_set(pose itarget, drive_directions dir, int speed) {
-  pid_turn_set(itarget, dir, speed, default_turn_type, slew_turn_get());
+motion_handle Drive::pid_turn_set(pose itarget, drive_directions dir, int speed) {
+  return pid_turn_set(itarget, dir, speed, default_turn_type, slew_turn_get());
 }
-void Drive::pid_turn_set(pose itarget, drive_directions dir, int speed, bool slew_on) {
-  pid_turn_set(itarget, dir, speed, default_turn_type, slew_on);
+motion_handle Drive::pid_turn_set(pose itarget, drive_directions dir, int speed, bool slew_on) {
+  return pid_turn_set(itarget, dir, speed, default_turn_type, slew_on);
 }
-void Drive::pid_turn_set(pose itarget, drive_directions dir, int speed, e_angle_behavior behavior) {
-  pid_turn_set(itarget, dir, speed, behavior, slew_turn_get());
+motion_handle Drive::pid_turn_set(pose itarget, drive_directions dir, int speed, e_angle_behavior behavior) {
+  return pid_turn_set(itarget, dir, speed, behavior, slew_turn_get());
 }
 // Units
-void Drive::pid_turn_set(united_pose p_itarget, drive_directions dir, int speed) {
-  pid_turn_set(util::united_pose_to_pose(p_itarget), dir, speed);
+motion_handle Drive::pid_turn_set(united_pose p_itarget, drive_directions dir, int speed) {
+  return pid_turn_set(util::united_pose_to_pose(p_itarget), dir, speed);
 }
-void Drive::pid_turn_set(united_pose p_itarget, drive_directions dir, int speed, bool slew_on) {
-  pid_turn_set(util::united_pose_to_pose(p_itarget), dir, speed, slew_on);
+motion_handle Drive::pid_turn_set(united_pose p_itarget, drive_directions dir, int speed, bool slew_on) {
+  return pid_turn_set(util::united_pose_to_pose(p_itarget), dir, speed, slew_on);
 }
-void Drive::pid_turn_set(united_pose p_itarget, drive_directions dir, int speed, e_angle_behavior behavior) {
-  pid_turn_set(util::united_pose_to_pose(p_itarget), dir, speed, behavior);
+motion_handle Drive::pid_turn_set(united_pose p_itarget, drive_directions dir, int speed, e_angle_behavior behavior) {
+  return pid_turn_set(util::united_pose_to_pose(p_itarget), dir, speed, behavior);
 }
-void Drive::pid_turn_set(united_pose p_itarget, drive_directions dir, int speed, e_angle_behavior behavior, bool slew_on) {
-  pid_turn_set(util::united_pose_to_pose(p_itarget), dir, speed, behavior, slew_on);
+motion_handle Drive::pid_turn_set(united_pose p_itarget, drive_directions dir, int speed, e_angle_behavior behavior, bool slew_on) {
+  return pid_turn_set(util::united_pose_to_pose(p_itarget), dir, speed, behavior, slew_on);
 }
 
 /////
 // Turn to point base
 /////
-void Drive::pid_turn_set(pose itarget, drive_directions dir, int speed, e_angle_behavior behavior, bool slew_on) {
+motion_handle Drive::pid_turn_set(pose itarget, drive_directions dir, int speed, e_angle_behavior behavior, bool slew_on) {
   itarget = flip_pose(itarget);
   odom_imu_start = drive_imu_get();
 
@@ -194,4 +205,6 @@ void Drive::pid_turn_set(pose itarget, drive_directions dir, int speed, e_angle_
   pid_turn_set(target, speed, behavior, slew_on);
 
   drive_mode_set(TURN_TO_POINT);
+
+  return motion_current();
 }
@@ -5,6 +5,7 @@ file, You can obtain one at http://mozilla.org/MPL/2.0/.
 */
 
 #include "EZ-Template/drive/drive.hpp"
+#include "EZ-Template/odom_tracker.hpp"
 #include "EZ-Template/tracking_wheel.hpp"
 #include "EZ-Template/util.hpp"
 
@@ -12,19 +13,25 @@ using namespace ez;
 
 // Sets and gets
 void Drive::odom_x_set(double x) {
+  std::lock_guard<pros::Mutex> lock(odom_mutex);
   odom_current.x = x;
-  l_pose.x = x;
-  r_pose.x = x;
-  central_pose.x = x;
+  odom_tracking.x_set(x);
+  odom_recording_event(ODOM_FRAME_X_SET, x);
+  wall_reset = true;
   was_odom_just_set = true;
+  odom_history_count.store(0, std::memory_order_release);
+  odom_published.write(odom_current);
 }
 void Drive::odom_x_set(okapi::QLength p_x) { odom_x_set(p_x.convert(okapi::inch)); }
 void Drive::odom_y_set(double y) {
+  std::lock_guard<pros::Mutex> lock(odom_mutex);
   odom_current.y = y;
-  l_pose.y = y;
-  r_pose.y = y;
-  central_pose.y = y;
+  odom_tracking.y_set(y);
+  odom_recording_event(ODOM_FRAME_Y_SET, y);
+  wall_reset = true;
   was_odom_just_set = true;
+  odom_history_count.store(0, std::memory_order_release);
+  odom_published.write(odom_current);
 }
 void Drive::odom_y_set(okapi::QLength p_y) { odom_y_set(p_y.convert(okapi::inch)); }
 void Drive::odom_theta_set(double a) { drive_angle_set(a); }
@@ -61,183 +68,304 @@ void Drive::odom_reset() { odom_pose_set({0.0, 0.0, 0.0}); }
 void Drive::odom_enable(bool input) { odometry_enabled = input; }
 bool Drive::odom_enabled() { return odometry_enabled; }
 
-double Drive::odom_x_get() { return odom_current.x; }
-double Drive::odom_y_get() { return odom_current.y; }
-double Drive::odom_theta_get() { return odom_current.theta; }
-pose Drive::odom_pose_get() { return odom_current; }
-double Drive::drive_width_get() { return global_track_width; }
+double Drive::odom_x_get() { return odom_pose_get().x; }
+double Drive::odom_y_get() { return odom_pose_get().y; }
+double Drive::odom_theta_get() { return odom_pose_get().theta; }
+pose Drive::odom_pose_get() { return odom_published.read(); }
+
+// Pose history
+void Drive::odom_history_add(std::uint64_t time, pose input) {
+  int count = odom_history_count.load(std::memory_order_relaxed);
+  odom_history[count % ODOM_HISTORY_SIZE].write({time, input});
+  odom_history_count.store(count + 1, std::memory_order_release);
+}
+
+pose Drive::odom_pose_at(std::uint64_t time) {
+  int newest = odom_history_count.load(std::memory_order_acquire) - 1;
+  if (newest < 0) return odom_pose_get();
 
-std::pair<float, float> Drive::decide_vert_sensor(ez::tracking_wheel* tracker, bool is_tracker_enabled, float ime, float ime_track) {
-  float current = ime;
-  float track_width = ime_track;
-  if (is_tracker_enabled) {
-    current = tracker->get();
-    track_width = tracker->distance_to_center_get();
+  // Leave a slot of room, the oldest slot could be written over while this runs
+  int oldest = newest - ODOM_HISTORY_SIZE + 2;
+  if (oldest < 0) oldest = 0;
+
+  timed_pose high = odom_history[newest % ODOM_HISTORY_SIZE].read();
+  if (time >= high.time) return high.odom;
+  timed_pose low = odom_history[oldest % ODOM_HISTORY_SIZE].read();
+  if (time <= low.time) return low.odom;
+
+  // Binary search for the poses on either side of time
+  int low_index = oldest, high_index = newest;
+  while (high_index - low_index > 1) {
+    int mid_index = low_index + ((high_index - low_index) / 2);
+    timed_pose mid = odom_history[mid_index % ODOM_HISTORY_SIZE].read();
+    if (mid.time <= time) {
+      low_index = mid_index;
+      low = mid;
+    } else {
+      high_index = mid_index;
+      high = mid;
+    }
   }
 
-  return {current, track_width};
+  // Interpolate, heading isn't wrapped so it can be interpolated the same way
+  double t = high.time > low.time ? (double)(time - low.time) / (double)(high.time - low.time) : 0.0;
+  pose output;
+  output.x = low.odom.x + ((high.odom.x - low.odom.x) * t);
+  output.y = low.odom.y + ((high.odom.y - low.odom.y) * t);
+  output.theta = low.odom.theta + ((high.odom.theta - low.odom.theta) * t);
+  return output;
 }
 
-ez::pose Drive::solve_xy_vert(float p_track_width, float current_t, float delta_vert, float delta_t) {
-  pose output = {0.0, 0.0, 0.0};
+// Latency compensation
+void Drive::odom_latency_compensation_set(int latency) { odom_latency = latency < 0 ? 0 : latency; }
+void Drive::odom_latency_compensation_set(okapi::QTime p_latency) { odom_latency_compensation_set((int)p_latency.convert(okapi::millisecond)); }
+int Drive::odom_latency_compensation_get() { return odom_latency; }
+pose Drive::odom_pose_predict(int latency) { return odom_pose_predict_at(pros::micros() + ((std::uint64_t)latency * 1000)); }
+
+// Move the newest pose forward to time, keeping the speed and turn rate the robot has had recently
+pose Drive::odom_pose_predict_at(std::uint64_t time) {
+  const std::uint64_t window = 30000;  // us
 
-  // Figure out how far we've actually moved
-  float local_x = delta_vert;
-  float half_delta_t = 0.0;
-  if (delta_t != 0) {
-    half_delta_t = delta_t / 2.0;
-    float i = sin(half_delta_t) * 2.0;
-    local_x = (delta_vert / delta_t - p_track_width) * i;
+  int newest_index = odom_history_count.load(std::memory_order_acquire) - 1;
+  if (newest_index < 1) return odom_pose_get();
+  int oldest_index = newest_index - ODOM_HISTORY_SIZE + 2;
+  if (oldest_index < 0) oldest_index = 0;
+  timed_pose newest = odom_history[newest_index % ODOM_HISTORY_SIZE].read();
+  timed_pose past = odom_history[oldest_index % ODOM_HISTORY_SIZE].read();
+
+  // Use the last window of history, or all of it if there isn't that much yet
+  if (newest.time - past.time > window) {
+    past.time = newest.time - window;
+    past.odom = odom_pose_at(past.time);
   }
+  if (newest.time <= past.time || time <= newest.time) return newest.odom;
+
+  return odom_pose_extrapolate(past.odom, newest.odom, (newest.time - past.time) / 1000000.0, (time - newest.time) / 1000000.0);
+}
 
-  float alpha = current_t - half_delta_t;
-  float x = cos(alpha) * local_x;
-  float y = sin(alpha) * local_x;
+void Drive::odom_heading_set(e_odom_heading heading) {
+  std::lock_guard<pros::Mutex> lock(odom_mutex);
+  odom_heading = heading;
+  odom_tracking.fusion_reset();
+  odom_recording_event(ODOM_FRAME_FUSION_RESET);
+}
+e_odom_heading Drive::odom_heading_get() { return odom_heading; }
+void Drive::odom_heading_fusion_time_constant_set(int time) { fusion_time_constant = time < 0 ? 0 : time; }
+void Drive::odom_heading_fusion_time_constant_set(okapi::QTime p_time) { odom_heading_fusion_time_constant_set((int)p_time.convert(okapi::millisecond)); }
+int Drive::odom_heading_fusion_time_constant_get() { return fusion_time_constant; }
+void Drive::odom_heading_fusion_gate_set(double rate) { fusion_gate = fabs(rate); }
+double Drive::odom_heading_fusion_gate_get() { return fusion_gate; }
 
-  // xy is calculated internally using math standard but translated to what's intuitive
-  // where going forward from 0 degrees increases Y
-  output.x = -y;
-  output.y = x;
+void Drive::odom_integrator_set(e_odom_integrator integrator) { odom_integrator = integrator; }
+e_odom_integrator Drive::odom_integrator_get() { return odom_integrator; }
+pose Drive::odom_integrator_pose_get(e_odom_integrator integrator) {
+  return odom_integrator_published[integrator].read();
+}
 
-  return output;
+void Drive::odom_least_squares_weights_set(double tracker, double ime, double imu) {
+  least_squares_weight.tracker = fmax(tracker, 0.0);
+  least_squares_weight.ime = fmax(ime, 0.0);
+  least_squares_weight.imu = fmax(imu, 0.0);
+}
+Drive::least_squares_weights Drive::odom_least_squares_weights_get() { return least_squares_weight; }
+void Drive::odom_least_squares_tracker_add(tracking_wheel* input, double x, double y, double angle, double weight) {
+  std::lock_guard<pros::Mutex> lock(odom_mutex);
+  if (least_squares_extra_count >= ODOM_LEAST_SQUARES_MAX) {
+    printf("Too many least squares tracking wheels, this one won't be used!\n");
+    return;
+  }
+  if (!tracking_wheel::register_wheel(input)) {
+    printf("Too many tracking wheels, this least squares tracker won't be used!\n");
+    return;
+  }
+  least_squares_extra& extra = least_squares_extras[least_squares_extra_count++];
+  extra.tracker = input;
+  extra.sensor = odom_least_squares_sensor_make(x, y, angle, weight);
+}
+
+// Odometry task
+void Drive::odom_task_period_set(int period) {
+  odom_task_period = period < 1 ? 1 : period;
+  odom_task_timing_reset();
+}
+void Drive::odom_task_period_set(okapi::QTime p_period) { odom_task_period_set((int)p_period.convert(okapi::millisecond)); }
+int Drive::odom_task_period_get() { return odom_task_period; }
+Drive::task_timing Drive::odom_task_timing_get() { return odom_timing; }
+void Drive::odom_task_timing_reset() {
+  odom_timing = {};
+  odom_timing.period = odom_task_period;
+  odom_timing_last_tick = 0;
+}
+
+void Drive::ez_odom_task() {
+  std::uint32_t next_wake = pros::millis();
+  while (true) {
+    // Pick up period changes at the start of a tick
+    if (odom_timing.period != odom_task_period) odom_task_timing_reset();
+    task_timing_iterate(&odom_timing, &odom_timing_last_tick, pros::micros());
+
+    ez_tracking_task();
+
+    task_deadline_wait(&odom_timing, &next_wake);
+  }
+}
+
+// This is used for PID as a "current" sensor value
+// what this value actually is doesn't matter, it just needs to move with the correct sign
+void Drive::xy_fake_iterate() {
+  xy_current_fake = fabs(is_past_target({0.0, 0.0}, drive_frame.odom));
+  if (!was_odom_just_set)
+    xy_delta_fake = fabs(xy_current_fake - xy_last_fake);
+  else
+    was_odom_just_set = false;
+  xy_last_fake = xy_current_fake;
 }
+double Drive::drive_width_get() { return global_track_width; }
 
-ez::pose Drive::solve_xy_horiz(float p_track_width, float current_t, float delta_horiz, float delta_t) {
-  pose output = {0.0, 0.0, 0.0};
+// Everything odometry needs to know about how the robot is set up, and the least squares sensor values when input isn't nullptr
+odom_tracker_config Drive::tracker_config_build(odom_tracker_input* input) {
+  odom_tracker_config config;
+  config.tracker_left = odom_tracker_left_enabled;
+  config.tracker_right = odom_tracker_right_enabled;
+  config.tracker_front = odom_tracker_front_enabled;
+  config.tracker_back = odom_tracker_back_enabled;
+  config.tracker_left_width = odom_tracker_left_enabled ? odom_tracker_left->distance_to_center_get() : 0.0;
+  config.tracker_right_width = odom_tracker_right_enabled ? odom_tracker_right->distance_to_center_get() : 0.0;
+  config.tracker_front_width = odom_tracker_front_enabled ? odom_tracker_front->distance_to_center_get() : 0.0;
+  config.tracker_back_width = odom_tracker_back_enabled ? odom_tracker_back->distance_to_center_get() : 0.0;
+  config.ime_width_left = odom_ime_track_width_left;
+  config.ime_width_right = odom_ime_track_width_right;
+  config.drive_integrated = is_tracker == DRIVE_INTEGRATED;
+  config.use_left = odom_use_left;
+  config.integrator = odom_integrator;
+  config.fused_heading = odom_heading == ODOM_HEADING_FUSED;
+  config.fusion_time_constant = fusion_time_constant / 1000.0;
+  config.fusion_gate_rate = util::to_rad(fusion_gate);
 
-  // Figure out how far we've actually moved
-  float local_y = delta_horiz;
-  float half_delta_t = 0.0;
-  if (delta_t != 0) {
-    half_delta_t = delta_t / 2.0;
-    float i = sin(half_delta_t) * 2.0;
-    local_y = (delta_horiz / delta_t + p_track_width) * i;
+  // Least squares sensors, placed to match what the arcs assume about each one
+  config.least_squares_imu_weight = least_squares_weight.imu;
+  // This runs every tick, so the directions are only worked out once
+  static const odom_least_squares_sensor vertical = odom_least_squares_sensor_make(0.0, 0.0, 0.0);
+  static const odom_least_squares_sensor horizontal = odom_least_squares_sensor_make(0.0, 0.0, -90.0);
+  auto add = [&](const odom_least_squares_sensor& sensor, double value) {
+    if (config.least_squares_count >= ODOM_LEAST_SQUARES_MAX) return;
+    config.least_squares[config.least_squares_count] = sensor;
+    if (input) input->least_squares[config.least_squares_count] = value;
+    config.least_squares_count++;
+  };
+  double tracker_weight = least_squares_weight.tracker;
+  if (odom_tracker_left_enabled) add(odom_least_squares_sensor_move(vertical, config.tracker_left_width, 0.0, tracker_weight), odom_frame.tracker_left);
+  if (odom_tracker_right_enabled) add(odom_least_squares_sensor_move(vertical, config.tracker_right_width, 0.0, tracker_weight), odom_frame.tracker_right);
+  if (odom_tracker_back_enabled) add(odom_least_squares_sensor_move(horizontal, 0.0, -config.tracker_back_width, tracker_weight), odom_frame.tracker_back);
+  if (odom_tracker_front_enabled) add(odom_least_squares_sensor_move(horizontal, 0.0, -config.tracker_front_width, tracker_weight), odom_frame.tracker_front);
+  if (is_tracker != ODOM_TRACKER) {
+    add(odom_least_squares_sensor_move(vertical, odom_ime_track_width_left, 0.0, least_squares_weight.ime), odom_frame.left);
+    add(odom_least_squares_sensor_move(vertical, odom_ime_track_width_right, 0.0, least_squares_weight.ime), odom_frame.right);
+  }
+  for (int i = 0; i < least_squares_extra_count; i++) {
+    const least_squares_extra& extra = least_squares_extras[i];
+    add(extra.sensor, input ? extra.tracker->last_get() : 0.0);
   }
 
-  float alpha = current_t - half_delta_t;
-  float x = -sin(alpha) * local_y;
-  float y = cos(alpha) * local_y;
+  return config;
+}
 
-  // xy is calculated internally using math standard but translated to what's intuitive
-  // where going forward from 0 degrees increases Y
-  output.x = -y;
-  output.y = x;
+// Recording
+void Drive::odom_recording_start(int frames) {
+  std::lock_guard<pros::Mutex> recording_lock(odom_recording_mutex);
+  std::lock_guard<pros::Mutex> lock(odom_mutex);
+  odom_tracking.config_set(tracker_config_build());
+  odom_recorder.start(frames, odom_tracking.config_get(), odom_tracking.state_get());
+}
+void Drive::odom_recording_stop() {
+  std::lock_guard<pros::Mutex> lock(odom_mutex);
+  odom_recorder.stop();
+}
+bool Drive::odom_recording_running() { return odom_recorder.enabled(); }
+bool Drive::odom_recording_save(std::string path) {
+  if (path.rfind("/usd/", 0) == 0 && !ez::util::SD_CARD_ACTIVE) {
+    printf("No SD card found, can't save odom recording!\n");
+    return false;
+  }
+  std::lock_guard<pros::Mutex> recording_lock(odom_recording_mutex);
 
-  return output;
+  // Only what's recorded so far is saved, the tracking task keeps adding after it while the file is written
+  std::size_t frames, configs;
+  {
+    std::lock_guard<pros::Mutex> lock(odom_mutex);
+    frames = odom_recorder.size();
+    configs = odom_recorder.config_size();
+  }
+  if (!odom_recorder.save(path.c_str(), frames, configs)) {
+    printf("Couldn't save odom recording to %s!\n", path.c_str());
+    return false;
+  }
+  return true;
 }
-// pose central_pose;
+void Drive::odom_recording_event(e_odom_frame type, double value) {
+  if (!odom_recorder.enabled()) return;
+  odom_recording_frame frame;
+  frame.type = type;
+  frame.input.time = pros::micros();
+  frame.value = value;
+  odom_recorder.record(frame);
+}
+
 // Tracking based on https://wiki.purduesigbots.com/software/odometry
 void Drive::ez_tracking_task() {
+  EZ_PROFILE(drive_stage_timers[STAGE_TRACKING]);
+
   // Don't let this function run if odom is disabled
   // and make sure all the "lasts" are 0
   if (!imu_calibration_complete || !odometry_enabled) {
-    h_last = 0.0;
-    t_last = 0.0;
-    l_last = 0.0;
-    r_last = 0.0;
+    std::lock_guard<pros::Mutex> lock(odom_mutex);
+    const odom_tracker_state& state = odom_tracking.state_get();
+    bool was_reset = state.h_last == 0.0 && state.t_last == 0.0 && state.l_last == 0.0 && state.r_last == 0.0 && state.fusion_reset;
+    odom_tracking.lasts_reset();
+    odom_tracking.fusion_reset();
+    if (!was_reset) {
+      odom_recording_event(ODOM_FRAME_LASTS_RESET);
+      odom_recording_event(ODOM_FRAME_FUSION_RESET);
+    }
     return;
   }
 
-  // Decide on using a horiz tracker vs not
-
-  ez::tracking_wheel* h_sensor = odom_tracker_back != nullptr ? odom_tracker_back : odom_tracker_front;
-  bool h_tracker_enabled = h_sensor == odom_tracker_back ? odom_tracker_back_enabled : odom_tracker_front_enabled;
-  std::pair<float, float> h_cur_and_track = decide_vert_sensor(h_sensor, h_tracker_enabled);
-  float h_current = h_cur_and_track.first;
-  float h_track_width = h_cur_and_track.second;
-  // Calculate velocity based on horiz value
-  float h_ = h_current - h_last;
-  h_last = h_current;
-
-  // Decide on left ime vs left tracker
-  std::pair<float, float> l_cur_and_track = decide_vert_sensor(odom_tracker_left, odom_tracker_left_enabled, drive_sensor_left(), odom_ime_track_width_left);
-  float l_current = l_cur_and_track.first;
-  float l_track_width = l_cur_and_track.second;
-  // Calculate velocity based on left value
-  float l_ = l_current - l_last;
-  l_last = l_current;
-
-  // Decide on right ime vs right tracker
-  std::pair<float, float> r_cur_and_track = decide_vert_sensor(odom_tracker_right, odom_tracker_right_enabled, drive_sensor_right(), odom_ime_track_width_right);
-  float r_current = r_cur_and_track.first;
-  float r_track_width = r_cur_and_track.second;
-  // Calculate velocity based on left value
-  float r_ = r_current - r_last;
-  r_last = r_current;
-
-  // Angle and velocity
-  float t_current = -ez::util::to_rad(drive_imu_get());  // negative for math standard
-  float t_ = t_current - t_last;
-  t_last = t_current;
-
-  pose h_pose_ = solve_xy_horiz(h_track_width, t_current, h_, t_);
-  pose l_pose_ = solve_xy_vert(l_track_width, t_current, l_, t_);
-  pose r_pose_ = solve_xy_vert(r_track_width, t_current, r_, t_);
-
-  r_pose.x += r_pose_.x;
-  r_pose.y += r_pose_.y;
-  r_pose.x += h_pose_.x;
-  r_pose.y += h_pose_.y;
-
-  l_pose.x += l_pose_.x;
-  l_pose.y += l_pose_.y;
-  l_pose.x += h_pose_.x;
-  l_pose.y += h_pose_.y;
-
-  // Track width of 0, but the delta is avg of l+r
-  double avg = l_ + r_;
-  if (avg != 0.0)
-    avg /= 2.0;
-  pose central_pose_ = solve_xy_vert(0.0, t_current, avg, t_);
-  central_pose.x += central_pose_.x;
-  central_pose.y += central_pose_.y;
-  central_pose.x += h_pose_.x;
-  central_pose.y += h_pose_.y;
-
-  odom_current.x = central_pose.x;
-  odom_current.y = central_pose.y;
-
-  // If there is a single vert tracker, use it
-  if (odom_tracker_left_enabled != odom_tracker_right_enabled) {
-    if (odom_tracker_left_enabled) {
-      odom_current.x = l_pose.x;
-      odom_current.y = l_pose.y;
-    } else if (odom_tracker_right_enabled) {
-      odom_current.x = r_pose.x;
-      odom_current.y = r_pose.y;
-    }
-  }
-  // If both sides have a sensor (2 vert trackers or 0 trackers), let the user pick what side
-  //  defaults to left tracker and central ime
-  else {
-    // If using IMEs, use central pose
-    if (is_tracker == DRIVE_INTEGRATED) {
-      odom_current.x = central_pose.x;
-      odom_current.y = central_pose.y;
-    } else if (odom_use_left) {
-      odom_current.x = l_pose.x;
-      odom_current.y = l_pose.y;
-    } else {
-      odom_current.x = r_pose.x;
-      odom_current.y = r_pose.y;
-    }
-  }
+  // Read every sensor once, without holding the lock so setters never wait on sensor reads
+  int resets = odom_sensor_resets.load();
+  sensor_frame_sample(&odom_frame, false);
 
-  odom_current.theta = drive_imu_get();
+  // Keep the setters from changing things while the pose is updated
+  std::lock_guard<pros::Mutex> lock(odom_mutex);
 
-  // This is used for PID as a "current" sensor value
-  // what this value actually is doesn't matter, it just needs to move with the correct sign
-  xy_current_fake = fabs(is_past_target({0.0, 0.0}, odom_pose_get()));
-  if (!was_odom_just_set)
-    xy_delta_fake = fabs(xy_current_fake - xy_last_fake);
-  else
-    was_odom_just_set = false;
-  xy_last_fake = xy_current_fake;
+  // Sensors were reset after they were read, so these readings don't line up with the lasts anymore
+  if (resets != odom_sensor_resets.load()) return;
+
+  // The math lives in odom_tracker so recordings can be replayed through it
+  odom_recording_frame tick;
+  tick.input.time = odom_frame.time;
+  tick.input.left = odom_frame.left;
+  tick.input.right = odom_frame.right;
+  tick.input.tracker_left = odom_frame.tracker_left;
+  tick.input.tracker_right = odom_frame.tracker_right;
+  tick.input.tracker_front = odom_frame.tracker_front;
+  tick.input.tracker_back = odom_frame.tracker_back;
+  tick.input.imu = odom_frame.imu;
+
+  odom_tracking.config_set(tracker_config_build(&tick.input));
+  odom_recorder.config_record(tick.input.time, odom_tracking.config_get());
+  pose used = odom_tracking.iterate(tick.input);
+  odom_integrator_published[0].write(odom_tracking.arc_get());
+  odom_integrator_published[1].write(odom_tracking.exp_get());
+  odom_integrator_published[2].write(odom_tracking.least_squares_get());
+
+  tick.output = used;
+  odom_recorder.record(tick);
 
-  // printf("odom_ime_track_width_left %f   l_ %f   r_ %f   t_current %f\n", odom_ime_track_width_left, r_, t_, t_current);
+  odom_current.x = used.x;
+  odom_current.y = used.y;
+  odom_current.theta = used.theta;
 
-  // printf("left (%.2f, %.2f)", l_pose.x, l_pose.y);
-  // printf("   right (%.2f, %.2f)", r_pose.x, r_pose.y);
-  // printf("   current used (%.2f, %.2f, %.2f)      l delta: %.2f   r delta: %.2f", odom_current.x, odom_current.y, odom_current.theta, l_, r_);
-  // printf("        htw: %f\n", h_track_width);
+  // Let everything else see the new pose
+  odom_published.write(odom_current);
+  odom_history_add(odom_frame.time, odom_current);
 }
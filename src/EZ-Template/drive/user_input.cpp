@@ -240,6 +240,12 @@ bool Drive::opcontrol_drive_reverse_get() { return is_reversed; }
 void Drive::opcontrol_joystick_threshold_iterate(int l_stick, int r_stick) {
   double l_out = 0.0, r_out = 0.0;
 
+  // Autotuning drives the robot until a joystick moves
+  if (pid_tuner_autotune_running()) {
+    if (l_stick == 0 && r_stick == 0) return;
+    pid_tuner_autotune_stop();
+  }
+
   // Check the motors are being set to power
   if (abs(l_stick) > 0 || abs(r_stick) > 0) {
     if (left_activebrakePID.constants_set_check()) opcontrol_drive_activebrake_targets_set();  // Update active brake PID targets
@@ -258,8 +264,9 @@ void Drive::opcontrol_joystick_threshold_iterate(int l_stick, int r_stick) {
   }
   // When joys are released, run active brake (P) on drive
   else {
-    l_out = left_activebrakePID.compute(drive_sensor_left());
-    r_out = right_activebrakePID.compute(drive_sensor_right());
+    std::uint64_t now = pros::micros();
+    l_out = left_activebrakePID.compute(drive_sensor_left(), now);
+    r_out = right_activebrakePID.compute(drive_sensor_right(), now);
   }
 
   // Constrain output between 127 and -127
@@ -0,0 +1,540 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla Public
+License, v. 2.0. If a copy of the MPL was not distributed with this
+file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include "EZ-Template/odom_tracker.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+#include "EZ-Template/fast_trig.hpp"
+
+using namespace ez;
+
+// Precision and trig used for tracking, picked with EZ_TEMPLATE_ODOM_PRECISION
+#if EZ_TEMPLATE_ODOM_PRECISION == 1
+typedef double odom_float;
+static inline odom_float odom_sin(odom_float x) { return sin(x); }
+static inline odom_float odom_cos(odom_float x) { return cos(x); }
+#elif EZ_TEMPLATE_ODOM_PRECISION == 2
+typedef float odom_float;
+static inline odom_float odom_sin(odom_float x) { return util::fast_sin(x); }
+static inline odom_float odom_cos(odom_float x) { return util::fast_cos(x); }
+#else
+typedef float odom_float;
+static inline odom_float odom_sin(odom_float x) { return sinf(x); }
+static inline odom_float odom_cos(odom_float x) { return cosf(x); }
+#endif
+
+void odom_tracker::x_set(double x) {
+  state.l_pose.x = x;
+  state.r_pose.x = x;
+  state.central_pose.x = x;
+  for (auto& p : state.exp_poses) p.x = x;
+  state.least_squares_pose.x = x;
+}
+
+void odom_tracker::y_set(double y) {
+  state.l_pose.y = y;
+  state.r_pose.y = y;
+  state.central_pose.y = y;
+  for (auto& p : state.exp_poses) p.y = y;
+  state.least_squares_pose.y = y;
+}
+
+void odom_tracker::shift(double dx, double dy) {
+  pose* poses[6] = {&state.l_pose, &state.r_pose, &state.central_pose, &state.exp_poses[0], &state.exp_poses[1], &state.exp_poses[2]};
+  for (auto p : poses) {
+    p->x += dx;
+    p->y += dy;
+  }
+  state.least_squares_pose.x += dx;
+  state.least_squares_pose.y += dy;
+}
+
+void odom_tracker::lasts_reset() {
+  state.h_last = 0.0;
+  state.l_last = 0.0;
+  state.r_last = 0.0;
+  state.t_last = 0.0;
+  for (auto& l : state.least_squares_last) l = 0.0;
+}
+
+// Trig every tracker shares on a tick
+odom_tracker::tracking_trig odom_tracker::tracking_trig_compute(double current_t, double delta_t) {
+  odom_float t = current_t;
+  odom_float d_t = delta_t;
+  odom_float half_delta_t = d_t / 2.0;
+  odom_float alpha = t - half_delta_t;
+
+  tracking_trig output;
+  output.delta_t = d_t;
+  output.two_sin_half = d_t != 0 ? odom_sin(half_delta_t) * 2.0 : 0.0;
+  output.sin_alpha = odom_sin(alpha);
+  output.cos_alpha = odom_cos(alpha);
+  return output;
+}
+
+pose odom_tracker::solve_xy_vert(const tracking_trig& trig, double p_track_width, double delta_vert) {
+  pose output = {0.0, 0.0, 0.0};
+
+  // Figure out how far we've actually moved
+  odom_float local_x = delta_vert;
+  if (trig.delta_t != 0)
+    local_x = ((odom_float)delta_vert / (odom_float)trig.delta_t - (odom_float)p_track_width) * (odom_float)trig.two_sin_half;
+
+  odom_float x = (odom_float)trig.cos_alpha * local_x;
+  odom_float y = (odom_float)trig.sin_alpha * local_x;
+
+  // xy is calculated internally using math standard but translated to what's intuitive
+  // where going forward from 0 degrees increases Y
+  output.x = -y;
+  output.y = x;
+
+  return output;
+}
+
+pose odom_tracker::solve_xy_horiz(const tracking_trig& trig, double p_track_width, double delta_horiz) {
+  pose output = {0.0, 0.0, 0.0};
+
+  // Figure out how far we've actually moved
+  odom_float local_y = delta_horiz;
+  if (trig.delta_t != 0)
+    local_y = ((odom_float)delta_horiz / (odom_float)trig.delta_t + (odom_float)p_track_width) * (odom_float)trig.two_sin_half;
+
+  odom_float x = -(odom_float)trig.sin_alpha * local_y;
+  odom_float y = (odom_float)trig.cos_alpha * local_y;
+
+  // xy is calculated internally using math standard but translated to what's intuitive
+  // where going forward from 0 degrees increases Y
+  output.x = -y;
+  output.y = x;
+
+  return output;
+}
+
+// For a constant twist this lands on the same point as the arc math, but it doesn't divide by delta_t
+// so it stays accurate when the robot barely turns.  The rotation from the start of the tick plus the
+// half turn of the chord is the angle halfway through the tick, so this reuses the tick's shared trig
+pose odom_tracker::exp_map_apply(const tracking_trig& trig, double forward, double sideways) {
+  // Chord length over arc length, 2 * sin(dt/2) / dt, using a series when dt is small
+  odom_float d_t = trig.delta_t;
+  odom_float scale = fabs(d_t) < 1e-3 ? 1.0 - (d_t * d_t / 24.0) : (odom_float)trig.two_sin_half / d_t;
+
+  // Movement along the chord, rotated into the field
+  odom_float local_x = scale * (odom_float)forward;
+  odom_float local_y = scale * (odom_float)sideways;
+  odom_float x = ((odom_float)trig.cos_alpha * local_x) - ((odom_float)trig.sin_alpha * local_y);
+  odom_float y = ((odom_float)trig.sin_alpha * local_x) + ((odom_float)trig.cos_alpha * local_y);
+
+  // xy is calculated internally using math standard but translated to what's intuitive
+  // where going forward from 0 degrees increases Y
+  return {-y, x, 0.0};
+}
+
+pose odom_tracker::exp_map_step(double start_t, double delta_t, double forward, double sideways) {
+  return exp_map_apply(tracking_trig_compute(start_t + delta_t, delta_t), forward, sideways);
+}
+
+pose ez::odom_pose_extrapolate(const pose& past, const pose& newest, double span, double ahead) {
+  if (span <= 0.0 || ahead <= 0.0) return newest;
+
+  // Speed in the robot's frame, using the heading halfway through
+  double heading = ((newest.theta + past.theta) / 2.0) * (M_PI / 180);
+  double dx = newest.x - past.x;
+  double dy = newest.y - past.y;
+  double forward_speed = ((dx * sin(heading)) + (dy * cos(heading))) / span;
+  double right_speed = ((dx * cos(heading)) - (dy * sin(heading))) / span;
+  double turn_speed = (newest.theta - past.theta) / span;
+
+  // Keep moving like that, negatives are for math standard
+  double to_rad = M_PI / 180;
+  pose step = odom_tracker::exp_map_step(-newest.theta * to_rad, -turn_speed * ahead * to_rad, forward_speed * ahead, -right_speed * ahead);
+  return {newest.x + step.x, newest.y + step.y, newest.theta + (turn_speed * ahead)};
+}
+
+// A sensor pointing along u at p reads u . (v + w x p), robot frame in math standard is x forwards and y to the left
+odom_least_squares_sensor ez::odom_least_squares_sensor_make(double x, double y, double angle, double weight) {
+  odom_least_squares_sensor direction;
+  direction.angle = angle;
+  odom_float a = angle * (M_PI / 180);
+  direction.u_x = odom_cos(a);
+  direction.u_y = -odom_sin(a);
+  return odom_least_squares_sensor_move(direction, x, y, weight);
+}
+
+odom_least_squares_sensor ez::odom_least_squares_sensor_move(const odom_least_squares_sensor& direction, double x, double y, double weight) {
+  odom_least_squares_sensor sensor = direction;
+  sensor.x = x;
+  sensor.y = y;
+  sensor.weight = weight;
+  double p_x = y;
+  double p_y = -x;
+  sensor.moment = (sensor.u_y * p_x) - (sensor.u_x * p_y);
+  return sensor;
+}
+
+// Solves m * output = b with gaussian elimination, returns false if m can't be solved
+bool odom_tracker::solve_3x3(double m[3][3], double b[3], double* output) {
+  for (int col = 0; col < 3; col++) {
+    // Swap the biggest row up to keep this stable
+    int pivot = col;
+    for (int row = col + 1; row < 3; row++) {
+      if (fabs(m[row][col]) > fabs(m[pivot][col])) pivot = row;
+    }
+    if (fabs(m[pivot][col]) < 1e-12) return false;
+    if (pivot != col) {
+      for (int i = 0; i < 3; i++) std::swap(m[col][i], m[pivot][i]);
+      std::swap(b[col], b[pivot]);
+    }
+
+    for (int row = col + 1; row < 3; row++) {
+      double scale = m[row][col] / m[col][col];
+      for (int i = col; i < 3; i++) m[row][i] -= scale * m[col][i];
+      b[row] -= scale * b[col];
+    }
+  }
+
+  for (int row = 2; row >= 0; row--) {
+    double sum = b[row];
+    for (int i = row + 1; i < 3; i++) sum -= m[row][i] * output[i];
+    output[row] = sum / m[row][row];
+  }
+  return true;
+}
+
+// Finds the twist (forward, sideways, delta_t) that best explains every sensor, math standard.
+// Each sensor is a row of a weighted least squares problem
+void odom_tracker::least_squares_twist(const odom_tracker_input& input, double delta_t, double* output) {
+  int count = config.least_squares_count;
+
+  // When sensors are added or removed the lasts don't line up anymore, so start over from here
+  if (count != state.least_squares_count) {
+    for (int i = 0; i < count; i++) state.least_squares_last[i] = input.least_squares[i];
+    state.least_squares_count = count;
+  }
+
+  // Normal equations, the IMU is a sensor that only reads delta_t
+  double m[3][3] = {{0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}, {0.0, 0.0, config.least_squares_imu_weight}};
+  double b[3] = {0.0, 0.0, config.least_squares_imu_weight * delta_t};
+  for (int i = 0; i < count; i++) {
+    const odom_least_squares_sensor& sensor = config.least_squares[i];
+    double delta = input.least_squares[i] - state.least_squares_last[i];
+    state.least_squares_last[i] = input.least_squares[i];
+    if (sensor.weight <= 0.0) continue;
+
+    double row[3] = {sensor.u_x, sensor.u_y, sensor.moment};
+
+    for (int j = 0; j < 3; j++) {
+      for (int k = 0; k < 3; k++) m[j][k] += sensor.weight * row[j] * row[k];
+      b[j] += sensor.weight * row[j] * delta;
+    }
+  }
+
+  // Directions nothing reads (like sideways without a horizontal tracker) are pulled to 0
+  for (int i = 0; i < 3; i++) m[i][i] += 1e-9;
+
+  if (!solve_3x3(m, b, output)) {
+    output[0] = 0.0;
+    output[1] = 0.0;
+    output[2] = delta_t;
+  }
+}
+
+// Tracking based on https://wiki.purduesigbots.com/software/odometry
+pose odom_tracker::iterate(const odom_tracker_input& input) {
+  // Decide on using a horiz tracker vs not, back is used over front
+  float h_current = 0.0;
+  float h_track_width = 0.0;
+  if (config.tracker_back) {
+    h_current = input.tracker_back;
+    h_track_width = config.tracker_back_width;
+  } else if (config.tracker_front) {
+    h_current = input.tracker_front;
+    h_track_width = config.tracker_front_width;
+  }
+  // Calculate velocity based on horiz value
+  float h_ = h_current - state.h_last;
+  state.h_last = h_current;
+
+  // Decide on left ime vs left tracker
+  float l_current = config.tracker_left ? input.tracker_left : input.left;
+  float l_track_width = config.tracker_left ? config.tracker_left_width : config.ime_width_left;
+  // Calculate velocity based on left value
+  float l_ = l_current - state.l_last;
+  state.l_last = l_current;
+
+  // Decide on right ime vs right tracker
+  float r_current = config.tracker_right ? input.tracker_right : input.right;
+  float r_track_width = config.tracker_right ? config.tracker_right_width : config.ime_width_right;
+  // Calculate velocity based on left value
+  float r_ = r_current - state.r_last;
+  state.r_last = r_current;
+
+  // Angle and velocity
+  float t_imu = -(input.imu * (M_PI / 180));  // negative for math standard
+  float t_imu_ = t_imu - state.t_last;
+  state.t_last = t_imu;
+
+  // Heading change from the difference between left and right, when they're apart
+  float wheel_t_ = t_imu_;
+  if (r_track_width != l_track_width)
+    wheel_t_ = (r_ - l_) / (r_track_width - l_track_width);
+
+  // The fused heading is the IMU with its drift taken out.  Drift is learned from how much faster the IMU turns
+  // than the wheels, but only while the robot is barely turning and they agree, so slip and track width error
+  // never get in.  Everything is scaled by the time between ticks so it's the same at any task period
+  if (state.fusion_reset) {
+    state.fused_t = t_imu;
+    state.fused_last = t_imu;
+    state.fusion_reset = false;
+  } else {
+    double dt = input.time > state.fusion_time ? (input.time - state.fusion_time) / 1000000.0 : 0.0;
+    state.fused_t += t_imu_ - (state.imu_bias * dt);
+
+    bool wheels_have_heading = r_track_width != l_track_width;
+    if (wheels_have_heading && dt > 0.0) {
+      double imu_rate = t_imu_ / dt;
+      double disagreement = ((t_imu_ - wheel_t_) / dt) - state.imu_bias;
+      double gate = config.fusion_gate_rate;
+      if (fabs(imu_rate) < gate && fabs(disagreement) < gate) {
+        double tau = config.fusion_time_constant;
+        state.imu_bias += tau > 0.0 ? disagreement * (dt / (tau + dt)) : disagreement;
+      }
+    }
+  }
+  state.fusion_time = input.time;
+  float fused_ = state.fused_t - state.fused_last;
+  state.fused_last = state.fused_t;
+
+  bool use_fused = config.fused_heading;
+  float t_current = use_fused ? state.fused_t : t_imu;
+  float t_ = use_fused ? fused_ : t_imu_;
+
+  // Every tracker moves along the same arc, so trig is only computed once
+  tracking_trig trig = tracking_trig_compute(t_current, t_);
+
+  pose h_pose_ = solve_xy_horiz(trig, h_track_width, h_);
+  pose l_pose_ = solve_xy_vert(trig, l_track_width, l_);
+  pose r_pose_ = solve_xy_vert(trig, r_track_width, r_);
+
+  state.r_pose.x += r_pose_.x;
+  state.r_pose.y += r_pose_.y;
+  state.r_pose.x += h_pose_.x;
+  state.r_pose.y += h_pose_.y;
+
+  state.l_pose.x += l_pose_.x;
+  state.l_pose.y += l_pose_.y;
+  state.l_pose.x += h_pose_.x;
+  state.l_pose.y += h_pose_.y;
+
+  // Track width of 0, but the delta is avg of l+r
+  double avg = l_ + r_;
+  if (avg != 0.0)
+    avg /= 2.0;
+  pose central_pose_ = solve_xy_vert(trig, 0.0, avg);
+  state.central_pose.x += central_pose_.x;
+  state.central_pose.y += central_pose_.y;
+  state.central_pose.x += h_pose_.x;
+  state.central_pose.y += h_pose_.y;
+
+  // Exponential map, with the same sensors as above.  Trackers move by their offset times the turn,
+  // so take that out to get how far the center of the robot moved
+  double sideways = h_ + (h_track_width * t_);
+  double forwards[3] = {l_ - (l_track_width * t_), r_ - (r_track_width * t_), avg};
+  for (int i = 0; i < 3; i++) {
+    pose step = exp_map_apply(trig, forwards[i], sideways);
+    state.exp_poses[i].x += step.x;
+    state.exp_poses[i].y += step.y;
+  }
+
+  // Least squares, every sensor is used together
+  double twist[3];
+  least_squares_twist(input, t_, twist);
+  // It turns by its own amount, so it needs its own halfway angle
+  double start_t = t_current - t_;
+  tracking_trig least_squares_trig = tracking_trig_compute(start_t + twist[2], twist[2]);
+  pose least_squares_step = exp_map_apply(least_squares_trig, twist[0], twist[1]);
+  state.least_squares_pose.x += least_squares_step.x;
+  state.least_squares_pose.y += least_squares_step.y;
+
+  // Pick which sensor the pose comes from, 0 is left, 1 is right and 2 is central
+  int source = 2;
+
+  // If there is a single vert tracker, use it
+  if (config.tracker_left != config.tracker_right) {
+    source = config.tracker_left ? 0 : 1;
+  }
+  // If both sides have a sensor (2 vert trackers or 0 trackers), let the user pick what side
+  //  defaults to left tracker and central ime
+  else {
+    // If using IMEs, use central pose
+    if (config.drive_integrated)
+      source = 2;
+    else if (config.use_left)
+      source = 0;
+    else
+      source = 1;
+  }
+
+  const pose* arc_poses[3] = {&state.l_pose, &state.r_pose, &state.central_pose};
+  double theta = use_fused ? -(state.fused_t * (180 / M_PI)) : input.imu;
+  arc = {arc_poses[source]->x, arc_poses[source]->y, theta};
+  exp = {state.exp_poses[source].x, state.exp_poses[source].y, theta};
+  least_squares = {state.least_squares_pose.x, state.least_squares_pose.y, theta};
+
+  if (config.integrator == 2) return least_squares;
+  return config.integrator == 1 ? exp : arc;
+}
+
+// Recording
+void odom_recording::start(int frames, const odom_tracker_config& config, const odom_tracker_state& state) {
+  if (frames <= 0) {
+    std::vector<odom_recording_frame>().swap(buffer);
+    std::vector<odom_tracker_config>().swap(configs);
+  } else {
+    buffer.assign(frames, odom_recording_frame());
+    configs.assign(ODOM_RECORDING_CONFIG_MAX, odom_tracker_config());
+  }
+  count = 0;
+  config_count = 0;
+  running = frames > 0;
+  header.config = config;
+  header.state = state;
+  last_config = config;
+}
+
+void odom_recording::config_record(std::uint64_t time, const odom_tracker_config& config) {
+  if (!running || config == last_config) return;
+
+  // A replay would silently use the wrong config past this point, so stop instead
+  if (config_count >= configs.size()) {
+    running = false;
+    return;
+  }
+  configs[config_count] = config;
+  last_config = config;
+
+  odom_recording_frame frame;
+  frame.type = ODOM_FRAME_CONFIG;
+  frame.input.time = time;
+  frame.value = config_count;
+  config_count++;
+  record(frame);
+}
+
+bool odom_recording::save(const char* path, std::size_t frames, std::size_t config_frames) const {
+  std::FILE* file = std::fopen(path, "wb");
+  if (!file) return false;
+
+  odom_recording_header output = header;
+  output.count = frames;
+  output.config_count = config_frames;
+  bool ok = std::fwrite(&output, sizeof(output), 1, file) == 1;
+  if (ok && frames > 0) ok = std::fwrite(buffer.data(), sizeof(odom_recording_frame), frames, file) == frames;
+  if (ok && config_frames > 0) ok = std::fwrite(configs.data(), sizeof(odom_tracker_config), config_frames, file) == config_frames;
+
+  std::fclose(file);
+  return ok;
+}
+
+bool ez::odom_recording_read(const char* path, odom_recording_header* header, std::vector<odom_recording_frame>* frames, std::vector<odom_tracker_config>* configs) {
+  frames->clear();
+  configs->clear();
+  std::FILE* file = std::fopen(path, "rb");
+  if (!file) return false;
+
+  odom_recording_header expected;
+  bool ok = std::fread(header, sizeof(*header), 1, file) == 1 &&
+            std::memcmp(header->magic, expected.magic, sizeof(header->magic)) == 0 &&
+            header->version == expected.version && header->frame_size == expected.frame_size &&
+            header->config_size == expected.config_size;
+  if (ok) {
+    frames->resize(header->count);
+    ok = std::fread(frames->data(), sizeof(odom_recording_frame), header->count, file) == header->count;
+  }
+  if (ok) {
+    configs->resize(header->config_count);
+    ok = std::fread(configs->data(), sizeof(odom_tracker_config), header->config_count, file) == header->config_count;
+  }
+
+  std::fclose(file);
+  if (!ok) {
+    frames->clear();
+    configs->clear();
+  }
+  return ok;
+}
+
+// Replay
+odom_replay_result ez::odom_replay(const odom_recording_header& header, const std::vector<odom_recording_frame>& frames, const std::vector<odom_tracker_config>& configs, std::uint64_t (*clock)()) {
+  odom_tracker tracker;
+  tracker.config_set(header.config);
+  tracker.state_set(header.state);
+
+  odom_replay_result result;
+  result.trace.reserve(frames.size());
+  for (const auto& frame : frames) {
+    switch (frame.type) {
+      case ODOM_FRAME_TICK: {
+        std::uint64_t start = clock ? clock() : 0;
+        pose output = tracker.iterate(frame.input);
+        if (clock) {
+          std::uint64_t elapsed = clock() - start;
+          result.total_time += elapsed;
+          if (elapsed > result.max_time) result.max_time = elapsed;
+        }
+        result.trace.push_back(output);
+
+        double error = hypot(output.x - frame.output.x, output.y - frame.output.y);
+        double theta_error = fabs(output.theta - frame.output.theta);
+        if (error > result.max_error) result.max_error = error;
+        if (theta_error > result.max_theta_error) result.max_theta_error = theta_error;
+        break;
+      }
+      case ODOM_FRAME_X_SET:
+        tracker.x_set(frame.value);
+        break;
+      case ODOM_FRAME_Y_SET:
+        tracker.y_set(frame.value);
+        break;
+      case ODOM_FRAME_T_LAST_SET:
+        tracker.t_last_set(frame.value);
+        break;
+      case ODOM_FRAME_LASTS_RESET:
+        tracker.lasts_reset();
+        break;
+      case ODOM_FRAME_FUSION_RESET:
+        tracker.fusion_reset();
+        break;
+      case ODOM_FRAME_X_SHIFT:
+        tracker.shift(frame.value, 0.0);
+        break;
+      case ODOM_FRAME_Y_SHIFT:
+        tracker.shift(0.0, frame.value);
+        break;
+      case ODOM_FRAME_CONFIG: {
+        std::size_t index = frame.value;
+        if (index < configs.size()) tracker.config_set(configs[index]);
+        break;
+      }
+      default:
+        break;
+    }
+  }
+  return result;
+}
+
+void ez::odom_replay_csv_write(const std::vector<odom_recording_frame>& frames, const odom_replay_result& result, std::FILE* file) {
+  std::fprintf(file, "time,x,y,theta,recorded_x,recorded_y,recorded_theta\n");
+  std::size_t tick = 0;
+  for (const auto& f : frames) {
+    if (f.type != ODOM_FRAME_TICK) continue;
+    if (tick >= result.trace.size()) break;
+    const pose& p = result.trace[tick++];
+    std::fprintf(file, "%.6f,%f,%f,%f,%f,%f,%f\n", f.input.time / 1000000.0, p.x, p.y, p.theta, f.output.x, f.output.y, f.output.theta);
+  }
+}
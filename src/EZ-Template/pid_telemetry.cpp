@@ -0,0 +1,105 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla Public
+License, v. 2.0. If a copy of the MPL was not distributed with this
+file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include "EZ-Template/pid_telemetry.hpp"
+
+#include <cstring>
+
+using namespace ez;
+
+pid_telemetry::pid_telemetry(const pid_telemetry& other) : buffer(other.buffer), head(other.head.load()), count(other.count.load()) {}
+
+pid_telemetry& pid_telemetry::operator=(const pid_telemetry& other) {
+  buffer = other.buffer;
+  head = other.head.load();
+  count = other.count.load();
+  return *this;
+}
+
+void pid_telemetry::resize(int samples) {
+  if (samples <= 0)
+    std::vector<pid_sample>().swap(buffer);
+  else
+    buffer.assign(samples, pid_sample());
+  clear();
+}
+
+void pid_telemetry::clear() {
+  head = 0;
+  count = 0;
+}
+
+int pid_telemetry::size() const { return count; }
+
+pid_sample pid_telemetry::get(int index) const {
+  if (index < 0 || (std::size_t)index >= count) return pid_sample();
+  std::size_t oldest = count < buffer.size() ? 0 : head.load();
+  return buffer[(oldest + index) % buffer.size()];
+}
+
+// Recording stops while samples are copied.  If this stopped a record() halfway through, the slot it was
+// writing is the oldest one once the buffer is full, so that one is left out
+std::vector<pid_sample> pid_telemetry::snapshot() const {
+  paused = true;
+  bool interrupted = writing;
+  std::size_t size = buffer.size();
+  std::size_t amount = count;
+
+  // Oldest samples are after head once the buffer has wrapped
+  std::size_t oldest = amount < size ? 0 : head.load();
+  if (interrupted && amount == size && amount > 0) {
+    oldest = (oldest + 1) % size;
+    amount--;
+  }
+
+  std::vector<pid_sample> output(amount);
+  for (std::size_t n = 0; n < amount; n++) output[n] = buffer[(oldest + n) % size];
+  paused = false;
+  return output;
+}
+
+bool pid_telemetry::save(const char* path) const {
+  // Copy first so recording only stops for the copy, not the file write
+  std::vector<pid_sample> samples = snapshot();
+
+  std::FILE* file = std::fopen(path, "wb");
+  if (!file) return false;
+
+  pid_telemetry_header header;
+  header.count = samples.size();
+  bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+  if (ok && !samples.empty()) ok = std::fwrite(samples.data(), sizeof(pid_sample), samples.size(), file) == samples.size();
+
+  std::fclose(file);
+  return ok;
+}
+
+bool ez::pid_telemetry_read(const char* path, std::vector<pid_sample>* output) {
+  output->clear();
+  std::FILE* file = std::fopen(path, "rb");
+  if (!file) return false;
+
+  pid_telemetry_header header, expected;
+  bool ok = std::fread(&header, sizeof(header), 1, file) == 1 &&
+            std::memcmp(header.magic, expected.magic, sizeof(header.magic)) == 0 &&
+            header.version == expected.version && header.sample_size == expected.sample_size;
+  if (ok) {
+    output->resize(header.count);
+    ok = std::fread(output->data(), sizeof(pid_sample), header.count, file) == header.count;
+  }
+
+  std::fclose(file);
+  if (!ok) output->clear();
+  return ok;
+}
+
+void ez::pid_telemetry_csv_write(const std::vector<pid_sample>& samples, std::FILE* file) {
+  std::fprintf(file, "time,target,current,error,p,i,d,output,small_exit_timer,big_exit_timer,velocity_exit_timer,mA_exit_timer\n");
+  for (const auto& s : samples) {
+    std::fprintf(file, "%.6f,%f,%f,%f,%f,%f,%f,%f,%u,%u,%u,%u\n", s.time / 1000000.0, s.target, s.current, s.error,
+                 s.p, s.i, s.d, s.output, s.small_exit_timer, s.big_exit_timer, s.velocity_exit_timer, s.mA_exit_timer);
+  }
+}
@@ -0,0 +1,50 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla Public
+License, v. 2.0. If a copy of the MPL was not distributed with this
+file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include "EZ-Template/profiler.hpp"
+
+using namespace ez;
+
+std::string ez::stage_to_string(e_stage input) {
+  switch ((int)input) {
+    case STAGE_TICK:
+      return "Tick";
+    case STAGE_TRACKING:
+      return "Tracking";
+    case STAGE_DRIVE_PID:
+      return "Drive PID";
+    case STAGE_TURN_PID:
+      return "Turn PID";
+    case STAGE_SWING_PID:
+      return "Swing PID";
+    case STAGE_PTP:
+      return "Point to Point";
+    case STAGE_PP:
+      return "Pure Pursuit";
+    case STAGE_DRIVE_SET:
+      return "Drive Set";
+    default:
+      return "Error: Out of bounds!";
+  }
+
+  return "Error: Out of bounds!";
+}
+
+void stage_timer::add(std::uint32_t us) {
+  if (current.count == 0 || us < current.min) current.min = us;
+  if (current.count == 0 || us > current.max) current.max = us;
+  current.count++;
+  current.mean += ((double)us - current.mean) / current.count;
+
+  // Bucket is the highest set bit of the sample
+  int bucket = us == 0 ? 0 : 31 - __builtin_clz(us);
+  if (bucket > BUCKETS - 1) bucket = BUCKETS - 1;
+  current.histogram[bucket]++;
+}
+
+void stage_timer::reset() { current = {}; }
+
+stage_timer::stats stage_timer::get() { return current; }
@@ -0,0 +1,144 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla Public
+License, v. 2.0. If a copy of the MPL was not distributed with this
+file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include "EZ-Template/relay_autotuner.hpp"
+
+#include <cmath>
+
+using namespace ez;
+
+relay_autotuner::relay_autotuner() {}
+
+void relay_autotuner::timeout_set(int time) { timeout = time < 0 ? 0 : time; }
+void relay_autotuner::rule_set(e_autotune_rule rule) { tuning_rule = rule; }
+void relay_autotuner::loop_time_set(double time) { loop_time = time; }
+e_autotune_state relay_autotuner::state_get() { return state; }
+relay_autotuner::Result relay_autotuner::result_get() { return result; }
+
+// Start a new experiment
+void relay_autotuner::initialize(double p_target, double relay_output, double p_hysteresis, int cycles_to_measure) {
+  target = p_target;
+  relay = fabs(relay_output);
+  hysteresis = fabs(p_hysteresis);
+  cycles_wanted = cycles_to_measure < 1 ? 1 : (cycles_to_measure > MAX_CYCLES ? MAX_CYCLES : cycles_to_measure);
+  output = relay;
+  start_time = 0;
+  last_rise = 0;
+  rises = 0;
+  cycles = 0;
+  result = {};
+  state = AUTOTUNE_RUNNING;
+}
+
+void relay_autotuner::stop() {
+  if (state == AUTOTUNE_RUNNING) state = AUTOTUNE_IDLE;
+  output = 0;
+}
+
+double relay_autotuner::iterate(double current, std::uint64_t time_us) {
+  if (state != AUTOTUNE_RUNNING) return 0.0;
+
+  if (start_time == 0) {
+    start_time = time_us;
+    peak_high = current;
+    peak_low = current;
+  }
+
+  // Give up if this is taking too long, the mechanism probably can't oscillate with this output
+  if (timeout != 0 && time_us - start_time > (std::uint64_t)timeout * 1000) {
+    state = AUTOTUNE_FAILED;
+    output = 0;
+    return 0.0;
+  }
+
+  peak_high = fmax(peak_high, current);
+  peak_low = fmin(peak_low, current);
+
+  // Flip the relay once error passes hysteresis
+  double error = target - current;
+  bool rising = false;
+  if (error > hysteresis && output < 0) {
+    output = relay;
+    rising = true;
+  } else if (error < -hysteresis && output > 0) {
+    output = -relay;
+  }
+
+  // Every time the relay goes positive is the start of a new cycle
+  if (rising) {
+    // The first cycle starts from rest, so it isn't measured
+    if (rises >= 2) {
+      periods[cycles] = (time_us - last_rise) / 1000000.0;
+      amplitudes[cycles] = (peak_high - peak_low) / 2.0;
+      cycles++;
+    }
+    rises++;
+    last_rise = time_us;
+    peak_high = current;
+    peak_low = current;
+
+    if (cycles >= cycles_wanted) {
+      result_compute();
+      output = 0;
+      return 0.0;
+    }
+  }
+
+  return output;
+}
+
+// Turn the measured oscillation into PID constants
+void relay_autotuner::result_compute() {
+  double period = 0.0, amplitude = 0.0;
+  for (int i = 0; i < cycles; i++) {
+    period += periods[i];
+    amplitude += amplitudes[i];
+  }
+  period /= cycles;
+  amplitude /= cycles;
+
+  // Describing function of a relay with hysteresis
+  double effective_amplitude = sqrt(fmax((amplitude * amplitude) - (hysteresis * hysteresis), 0.0));
+  if (effective_amplitude <= 0.0 || period <= 0.0) {
+    state = AUTOTUNE_FAILED;
+    return;
+  }
+
+  result.ultimate_gain = (4.0 * relay) / (M_PI * effective_amplitude);
+  result.ultimate_period = period;
+  result.amplitude = amplitude;
+
+  // Proportional gain, integral time and derivative time as fractions of Ku and Tu
+  double kp_scale, ti_scale, td_scale;
+  switch (tuning_rule) {
+    case AUTOTUNE_SOME_OVERSHOOT:
+      kp_scale = 0.33;
+      ti_scale = 0.5;
+      td_scale = 0.33;
+      break;
+    case AUTOTUNE_NO_OVERSHOOT:
+      kp_scale = 0.2;
+      ti_scale = 0.5;
+      td_scale = 0.33;
+      break;
+    case AUTOTUNE_CLASSIC:
+    default:
+      kp_scale = 0.6;
+      ti_scale = 0.5;
+      td_scale = 0.125;
+      break;
+  }
+
+  // i and d in EZ-Template are per loop instead of per second
+  double dt = loop_time / 1000.0;
+  double ti = ti_scale * period;
+  double td = td_scale * period;
+  result.kp = kp_scale * result.ultimate_gain;
+  result.ki = result.kp * dt / ti;
+  result.kd = result.kp * td / dt;
+
+  state = AUTOTUNE_DONE;
+}
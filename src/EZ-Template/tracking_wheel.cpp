@@ -6,10 +6,22 @@ file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 #include "EZ-Template/tracking_wheel.hpp"
 
+#include <mutex>
+
 #include "EZ-Template/util.hpp"
+#include "pros/rtos.hpp"
 
 using namespace ez;
 
+tracking_wheel* tracking_wheel::registered[tracking_wheel::MAX_REGISTERED] = {};
+int tracking_wheel::registered_count = 0;
+
+// Made on first use so it exists before any Drive constructed at startup registers a wheel
+static pros::Mutex& registry_mutex() {
+  static pros::Mutex mutex;
+  return mutex;
+}
+
 // ADI Encoder
 tracking_wheel::tracking_wheel(std::vector<int> ports, double wheel_diameter, double distance_to_center, double ratio)
     : adi_encoder(abs(ports[0]), abs(ports[1]), util::reversed_active(ports[0])),
@@ -47,10 +59,70 @@ tracking_wheel::tracking_wheel(int port, double wheel_diameter, double distance_
   ticks_per_rev_set(36000.0);
 }
 
-void tracking_wheel::ticks_per_rev_set(double input) { ENCODER_TICKS_PER_REV = fabs(input); }
+tracking_wheel::tracking_wheel(const tracking_wheel& other)
+    : adi_encoder(other.adi_encoder),
+      smart_encoder(other.smart_encoder),
+      IS_TRACKER(other.IS_TRACKER),
+      TICKS_PER_INCH(other.TICKS_PER_INCH),
+      INCHES_PER_TICK(other.INCHES_PER_TICK),
+      LAST_DISTANCE(other.LAST_DISTANCE.load(std::memory_order_relaxed)),
+      IS_FLIPPED(other.IS_FLIPPED),
+      DISTANCE_TO_CENTER(other.DISTANCE_TO_CENTER),
+      WHEEL_DIAMETER(other.WHEEL_DIAMETER),
+      RATIO(other.RATIO),
+      ENCODER_TICKS_PER_REV(other.ENCODER_TICKS_PER_REV),
+      WHEEL_TICK_PER_REV(other.WHEEL_TICK_PER_REV) {}
+
+tracking_wheel::~tracking_wheel() {
+  std::lock_guard<pros::Mutex> lock(registry_mutex());
+  for (int i = 0; i < registered_count; i++) {
+    if (registered[i] != this) continue;
+    // Shift everything after down so the order stays the same
+    for (int j = i; j < registered_count - 1; j++) registered[j] = registered[j + 1];
+    registered[--registered_count] = nullptr;
+    return;
+  }
+}
+
+// Registry
+bool tracking_wheel::register_wheel(tracking_wheel* input) {
+  std::lock_guard<pros::Mutex> lock(registry_mutex());
+  for (int i = 0; i < registered_count; i++) {
+    if (registered[i] == input) return true;
+  }
+  if (registered_count >= MAX_REGISTERED) return false;
+  registered[registered_count++] = input;
+  return true;
+}
+int tracking_wheel::registered_size() {
+  std::lock_guard<pros::Mutex> lock(registry_mutex());
+  return registered_count;
+}
+tracking_wheel* tracking_wheel::registered_get(int index) {
+  std::lock_guard<pros::Mutex> lock(registry_mutex());
+  if (index < 0 || index >= registered_count) return nullptr;
+  return registered[index];
+}
+int tracking_wheel::get_all(double* output, int max) {
+  // Held while reading so a wheel can't be destroyed mid read
+  std::lock_guard<pros::Mutex> lock(registry_mutex());
+  for (int i = 0; i < registered_count; i++) {
+    double distance = registered[i]->get();
+    if (output && i < max) output[i] = distance;
+  }
+  return registered_count;
+}
+
+void tracking_wheel::ticks_per_rev_set(double input) {
+  ENCODER_TICKS_PER_REV = fabs(input);
+  ticks_per_inch_update();
+}
 double tracking_wheel::ticks_per_rev_get() { return ENCODER_TICKS_PER_REV; }
 
-void tracking_wheel::ratio_set(double input) { RATIO = fabs(input); }
+void tracking_wheel::ratio_set(double input) {
+  RATIO = fabs(input);
+  ticks_per_inch_update();
+}
 double tracking_wheel::ratio_get() { return RATIO; }
 
 void tracking_wheel::distance_to_center_flip_set(bool input) { IS_FLIPPED = input; }
@@ -61,14 +133,19 @@ double tracking_wheel::distance_to_center_get() {
   return DISTANCE_TO_CENTER * flipped;
 }
 
-void tracking_wheel::wheel_diameter_set(double input) { WHEEL_DIAMETER = fabs(input); }
+void tracking_wheel::wheel_diameter_set(double input) {
+  WHEEL_DIAMETER = fabs(input);
+  ticks_per_inch_update();
+}
 double tracking_wheel::wheel_diameter_get() { return WHEEL_DIAMETER; }
 
-double tracking_wheel::ticks_per_inch() {
+void tracking_wheel::ticks_per_inch_update() {
   double c = WHEEL_DIAMETER * M_PI;
   WHEEL_TICK_PER_REV = ENCODER_TICKS_PER_REV * RATIO;
-  return WHEEL_TICK_PER_REV / c;
+  TICKS_PER_INCH = WHEEL_TICK_PER_REV / c;
+  INCHES_PER_TICK = TICKS_PER_INCH != 0 ? 1.0 / TICKS_PER_INCH : 0.0;
 }
+double tracking_wheel::ticks_per_inch() { return TICKS_PER_INCH; }
 
 double tracking_wheel::get_raw() {
   if (IS_TRACKER == DRIVE_ROTATION) {
@@ -77,12 +154,12 @@ double tracking_wheel::get_raw() {
   return adi_encoder.get_value();
 }
 double tracking_wheel::get() {
-  double tpi = ticks_per_inch();
   double raw = get_raw();
-  if (tpi != 0)
-    return raw / tpi;
-  return raw;
+  double distance = TICKS_PER_INCH != 0 ? raw * INCHES_PER_TICK : raw;
+  LAST_DISTANCE.store(distance, std::memory_order_relaxed);
+  return distance;
 }
+double tracking_wheel::last_get() { return LAST_DISTANCE.load(std::memory_order_relaxed); }
 
 void tracking_wheel::reset() {
   if (IS_TRACKER == DRIVE_ADI_ENCODER) {
@@ -0,0 +1,85 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla Public
+License, v. 2.0. If a copy of the MPL was not distributed with this
+file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include "EZ-Template/api.hpp"
+
+using namespace ez;
+
+// Constructor
+trapezoid_profile::trapezoid_profile() {}
+trapezoid_profile::trapezoid_profile(double max_velocity, double max_acceleration) {
+  constants_set(max_velocity, max_acceleration);
+}
+
+// Set constants
+void trapezoid_profile::constants_set(double max_velocity, double max_acceleration) {
+  constants.max_velocity = fabs(max_velocity);
+  constants.max_acceleration = fabs(max_acceleration);
+}
+trapezoid_profile::Constants trapezoid_profile::constants_get() { return constants; }
+
+bool trapezoid_profile::enabled() { return is_enabled; }
+double trapezoid_profile::duration_get() { return is_enabled ? (accel_time * 2.0) + cruise_time : 0.0; }
+
+// Initialize for the movement
+void trapezoid_profile::initialize(bool enabled, double p_distance) {
+  is_enabled = enabled && constants.max_velocity != 0 && constants.max_acceleration != 0;
+  sign = p_distance < 0 ? -1 : 1;
+  distance = fabs(p_distance);
+  if (!is_enabled) return;
+
+  // Distance it takes to get to max velocity
+  accel_time = constants.max_velocity / constants.max_acceleration;
+  double accel_distance = 0.5 * constants.max_acceleration * accel_time * accel_time;
+
+  // Triangle profile when max velocity can't be reached
+  if (accel_distance * 2.0 > distance) {
+    accel_time = sqrt(distance / constants.max_acceleration);
+    peak_velocity = constants.max_acceleration * accel_time;
+    cruise_time = 0.0;
+  } else {
+    peak_velocity = constants.max_velocity;
+    cruise_time = (distance - (accel_distance * 2.0)) / constants.max_velocity;
+  }
+}
+
+// State of the profile at a time since the motion started
+trapezoid_profile::State trapezoid_profile::sample(double time) {
+  State output;
+  if (!is_enabled) return output;
+
+  double a = constants.max_acceleration;
+  double total_time = (accel_time * 2.0) + cruise_time;
+
+  // Speeding up
+  if (time < accel_time) {
+    time = fmax(time, 0.0);
+    output.acceleration = a;
+    output.velocity = a * time;
+    output.position = 0.5 * a * time * time;
+  }
+  // Cruising
+  else if (time < accel_time + cruise_time) {
+    output.velocity = peak_velocity;
+    output.position = (0.5 * a * accel_time * accel_time) + (peak_velocity * (time - accel_time));
+  }
+  // Slowing down
+  else if (time < total_time) {
+    double time_left = total_time - time;
+    output.acceleration = -a;
+    output.velocity = a * time_left;
+    output.position = distance - (0.5 * a * time_left * time_left);
+  }
+  // Done
+  else {
+    output.position = distance;
+  }
+
+  output.position *= sign;
+  output.velocity *= sign;
+  output.acceleration *= sign;
+  return output;
+}
@@ -117,6 +117,8 @@ std::string exit_to_string(exit_output input) {
       return "mA";
     case ERROR_NO_CONSTANTS:
       return "Error: Exit condition constants not set!";
+    case INTERRUPTED_EXIT:
+      return "Interrupted";
     default:
       return "Error: Out of bounds!";
   }
@@ -0,0 +1,161 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla Public
+License, v. 2.0. If a copy of the MPL was not distributed with this
+file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+#include "EZ-Template/wall_localizer.hpp"
+
+#include <cmath>
+
+using namespace ez;
+
+int wall_localizer::sensor_add(const wall_sensor& sensor) {
+  if (sensors_count >= MAX_SENSORS) return -1;
+  sensors[sensors_count] = sensor;
+  return sensors_count++;
+}
+
+// xorshift32, fast and the same on every computer
+double wall_localizer::random_uniform() {
+  rng ^= rng << 13;
+  rng ^= rng >> 17;
+  rng ^= rng << 5;
+  return (rng >> 8) * (1.0 / 16777216.0);
+}
+
+// Box-Muller, standard deviation of 1
+double wall_localizer::random_gaussian() {
+  double u = random_uniform();
+  if (u < 1e-12) u = 1e-12;
+  return sqrt(-2.0 * log(u)) * cos(2.0 * M_PI * random_uniform());
+}
+
+void wall_localizer::reset(pose center, double spread) {
+  for (int i = 0; i < PARTICLES; i++) {
+    particle_x[i] = center.x + (random_gaussian() * spread);
+    particle_y[i] = center.y + (random_gaussian() * spread);
+    weight[i] = 1.0 / PARTICLES;
+  }
+}
+
+void wall_localizer::predict(double dx, double dy) {
+  // Wheels slip more the further they go
+  double noise = 0.02 + (0.05 * hypot(dx, dy));
+  for (int i = 0; i < PARTICLES; i++) {
+    particle_x[i] += dx + (random_gaussian() * noise);
+    particle_y[i] += dy + (random_gaussian() * noise);
+  }
+}
+
+double wall_localizer::expected_range(double x, double y, double theta, int sensor) const {
+  if (sensor < 0 || sensor >= sensors_count) return -1.0;
+  const wall_sensor& s = sensors[sensor];
+
+  // Where the sensor is on the field, x is right and y is forwards when theta is 0
+  double t = theta * (M_PI / 180);
+  double sin_t = sin(t);
+  double cos_t = cos(t);
+  double sx = x + (s.x * cos_t) + (s.y * sin_t);
+  double sy = y - (s.x * sin_t) + (s.y * cos_t);
+  if (sx <= field.min_x || sx >= field.max_x || sy <= field.min_y || sy >= field.max_y) return -1.0;
+
+  // Closest wall the beam hits
+  double a = (theta + s.angle) * (M_PI / 180);
+  double dir_x = sin(a);
+  double dir_y = cos(a);
+  double range = -1.0;
+  if (dir_x > 1e-9) range = (field.max_x - sx) / dir_x;
+  if (dir_x < -1e-9) range = (field.min_x - sx) / dir_x;
+  if (dir_y > 1e-9) {
+    double r = (field.max_y - sy) / dir_y;
+    if (range < 0 || r < range) range = r;
+  }
+  if (dir_y < -1e-9) {
+    double r = (field.min_y - sy) / dir_y;
+    if (range < 0 || r < range) range = r;
+  }
+  return range;
+}
+
+bool wall_localizer::update(double theta, const double* ranges) {
+  heading = theta;
+
+  // Readings are treated as mostly a gaussian around the wall, with a floor for game objects and robots in the way
+  const double outlier = 0.1 / MAX_RANGE;
+  bool used = false;
+  double total = 0.0;
+  for (int i = 0; i < PARTICLES; i++) {
+    double likelihood = 1.0;
+    for (int j = 0; j < sensors_count; j++) {
+      if (ranges[j] < 0.0 || ranges[j] >= MAX_RANGE) continue;
+      used = true;
+      double expected = expected_range(particle_x[i], particle_y[i], theta, j);
+      if (expected < 0.0) {
+        likelihood *= outlier;
+        continue;
+      }
+      double sigma = fmax(0.6, expected * 0.05);  // distance sensors are +-15mm close up and +-5% further out
+      double error = (ranges[j] - expected) / sigma;
+      likelihood *= (0.9 * exp(-0.5 * error * error) / (sigma * 2.5066282746)) + outlier;
+    }
+    weight[i] *= likelihood;
+    total += weight[i];
+  }
+  if (!used) return false;
+
+  // Nothing matched any particle, so forget this update
+  if (total <= 0.0 || !std::isfinite(total)) {
+    for (int i = 0; i < PARTICLES; i++) weight[i] = 1.0 / PARTICLES;
+    return false;
+  }
+
+  double squared = 0.0;
+  for (int i = 0; i < PARTICLES; i++) {
+    weight[i] /= total;
+    squared += weight[i] * weight[i];
+  }
+
+  // Resample when less than half of the particles are doing the work
+  if (1.0 / squared < PARTICLES / 2.0) resample();
+  return true;
+}
+
+// Low variance resampling, it keeps good particles in proportion to their weight
+void wall_localizer::resample() {
+  double step = 1.0 / PARTICLES;
+  double target = random_uniform() * step;
+  double sum = weight[0];
+  int index = 0;
+  for (int i = 0; i < PARTICLES; i++) {
+    while (target > sum && index < PARTICLES - 1) sum += weight[++index];
+    resample_x[i] = particle_x[index];
+    resample_y[i] = particle_y[index];
+    target += step;
+  }
+  for (int i = 0; i < PARTICLES; i++) {
+    particle_x[i] = resample_x[i];
+    particle_y[i] = resample_y[i];
+    weight[i] = step;
+  }
+}
+
+pose wall_localizer::estimate_get() const {
+  double x = 0.0, y = 0.0;
+  for (int i = 0; i < PARTICLES; i++) {
+    x += weight[i] * particle_x[i];
+    y += weight[i] * particle_y[i];
+  }
+  return {x, y, heading};
+}
+
+double wall_localizer::spread_get() const {
+  pose mean = estimate_get();
+  double variance = 0.0;
+  for (int i = 0; i < PARTICLES; i++) {
+    double dx = particle_x[i] - mean.x;
+    double dy = particle_y[i] - mean.y;
+    variance += weight[i] * ((dx * dx) + (dy * dy));
+  }
+  return sqrt(variance);
+}
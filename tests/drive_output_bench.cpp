@@ -0,0 +1,130 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla Public
+License, v. 2.0. If a copy of the MPL was not distributed with this
+file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+// Times the loop Drive::private_drive_set() runs every tick, before and after the drive output list.
+// Drive needs the whole of PROS, so both loops are copied here around a motor shaped like pros::Motor,
+// with move_voltage() and get_port() kept out of line like the calls into libpros are.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// Polymorphic like pros::Motor, so a copy is more than an int
+class bench_motor {
+ public:
+  explicit bench_motor(std::int8_t port) : port(port) {}
+  virtual ~bench_motor() = default;
+  virtual std::int32_t move_voltage(std::int32_t voltage) const;
+  std::int8_t get_port() const;
+
+ private:
+  std::int8_t port;
+};
+
+static volatile std::int32_t sent[22];
+__attribute__((noinline)) std::int32_t bench_motor::move_voltage(std::int32_t voltage) const {
+  sent[std::abs(port)] = voltage;
+  return 1;
+}
+__attribute__((noinline)) std::int8_t bench_motor::get_port() const { return port; }
+
+struct drive {
+  std::vector<bench_motor> left_motors, right_motors;
+  std::vector<int> pto_active;
+
+  // Before, every motor was copied and the pto list searched for it
+  bool pto_check(bench_motor check_if_pto) {
+    auto does_exist = std::find(pto_active.begin(), pto_active.end(), check_if_pto.get_port());
+    if (does_exist != pto_active.end())
+      return true;
+    return false;
+  }
+  void drive_set_before(int left, int right) {
+    for (auto i : left_motors) {
+      if (!pto_check(i)) i.move_voltage(left * (12000.0 / 127.0));
+    }
+    for (auto i : right_motors) {
+      if (!pto_check(i)) i.move_voltage(right * (12000.0 / 127.0));
+    }
+  }
+
+  // After, drive_output_update() builds the motors that get power when the pto list changes
+  static const int MAX_DRIVE_MOTORS = 21;
+  std::uint32_t pto_ports = 0;
+  bench_motor* left_output[MAX_DRIVE_MOTORS] = {};
+  bench_motor* right_output[MAX_DRIVE_MOTORS] = {};
+  int left_output_count = 0;
+  int right_output_count = 0;
+  static std::uint32_t pto_port_bit(int port) {
+    port = std::abs(port);
+    if (port < 1 || port > 32) return 0;
+    return 1u << (port - 1);
+  }
+  void drive_output_update() {
+    pto_ports = 0;
+    for (auto i : pto_active) pto_ports |= pto_port_bit(i);
+    left_output_count = 0;
+    for (auto& i : left_motors) {
+      if (left_output_count < MAX_DRIVE_MOTORS && !(pto_ports & pto_port_bit(i.get_port()))) left_output[left_output_count++] = &i;
+    }
+    right_output_count = 0;
+    for (auto& i : right_motors) {
+      if (right_output_count < MAX_DRIVE_MOTORS && !(pto_ports & pto_port_bit(i.get_port()))) right_output[right_output_count++] = &i;
+    }
+  }
+  void drive_set_after(int left, int right) {
+    std::int32_t left_mV = left * (12000.0 / 127.0);
+    std::int32_t right_mV = right * (12000.0 / 127.0);
+    for (int i = 0; i < left_output_count; i++) left_output[i]->move_voltage(left_mV);
+    for (int i = 0; i < right_output_count; i++) right_output[i]->move_voltage(right_mV);
+  }
+};
+
+static double ns_per_call(drive& d, bool after) {
+  const int calls = 2000000;
+  auto start = std::chrono::steady_clock::now();
+  for (int n = 0; n < calls; n++) {
+    int left = (n % 255) - 127, right = 127 - (n % 255);
+    if (after)
+      d.drive_set_after(left, right);
+    else
+      d.drive_set_before(left, right);
+  }
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() / calls;
+}
+
+int main() {
+  std::printf("motors per side, pto motors, before ns, after ns\n");
+  const int sides[] = {2, 3, 4};
+  for (int per_side : sides) {
+    for (int pto = 0; pto <= 2; pto += 2) {
+      drive d;
+      for (int i = 0; i < per_side; i++) {
+        d.left_motors.emplace_back(-(i + 1));
+        d.right_motors.emplace_back(i + 11);
+      }
+      // The first index can't be a pto, so take motors from the back of each side
+      if (pto > 0) {
+        d.pto_active.push_back(d.left_motors.back().get_port());
+        d.pto_active.push_back(d.right_motors.back().get_port());
+      }
+      d.drive_output_update();
+
+      // Best of a few runs, so other things on the computer don't count
+      double before = 1e9, after = 1e9;
+      for (int run = 0; run < 5; run++) {
+        before = std::min(before, ns_per_call(d, false));
+        after = std::min(after, ns_per_call(d, true));
+      }
+      std::printf("%d, %d, %.1f, %.1f\n", per_side, pto, before, after);
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,104 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla Public
+License, v. 2.0. If a copy of the MPL was not distributed with this
+file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+// Records the same drive at different odom task periods with an IMU that drifts and wheels that slip through
+// fast turns, then replays each recording with the fused heading.
+
+#include <cmath>
+#include <cstdio>
+
+#include "EZ-Template/odom_tracker.hpp"
+
+static int failures = 0;
+static void check(bool passed, const char* name) {
+  std::printf("%s %s\n", passed ? "pass" : "FAIL", name);
+  if (!passed) failures++;
+}
+
+struct fusion_result {
+  double imu_error;    // raw IMU minus real heading at the end, degrees
+  double fused_error;  // fused heading minus real heading at the end, degrees
+  double worst_fused;  // biggest fused error anywhere, degrees
+  double worst_wheel;  // biggest wheel heading error anywhere, degrees
+};
+
+// 20s of driving with a 90 degree turn every 5s that takes 0.5s.  The wheels read 30% too much turn and
+// the IMU drifts by drift degrees per second the whole time
+static fusion_result record_and_replay(int period_ms, double drift) {
+  const char* path = "bin/odom_heading_fusion_test.bin";
+  const double width = 12.0;
+
+  ez::odom_tracker_config config;
+  config.ime_width_left = -width / 2.0;
+  config.ime_width_right = width / 2.0;
+  config.fused_heading = true;
+
+  ez::odom_tracker tracker;
+  tracker.config_set(config);
+  ez::odom_recording recording;
+  recording.start(5000, tracker.config_get(), tracker.state_get());
+
+  double left = 0.0, right = 0.0, heading = 0.0, wheel_heading = 0.0;
+  std::vector<double> headings, wheel_headings, imu_headings;
+  for (int time = 0; time <= 20000; time += period_ms) {
+    double dt = period_ms / 1000.0;
+    double forward = 24.0 * dt;
+    double turn = time % 5000 > 2000 && time % 5000 <= 2500 ? (90.0 / 0.5) * dt : 0.0;
+    double wheel_turn = turn * 1.3;
+    heading += turn;
+    wheel_heading += wheel_turn;
+
+    // Turning right is the left side going forwards
+    left += forward + (wheel_turn * (M_PI / 180) * width / 2.0);
+    right += forward - (wheel_turn * (M_PI / 180) * width / 2.0);
+
+    ez::odom_recording_frame tick;
+    tick.input.time = (std::uint64_t)time * 1000;
+    tick.input.left = left;
+    tick.input.right = right;
+    tick.input.imu = heading + (drift * time / 1000.0);
+    tick.output = tracker.iterate(tick.input);
+    recording.record(tick);
+    headings.push_back(heading);
+    wheel_headings.push_back(wheel_heading);
+    imu_headings.push_back(tick.input.imu);
+  }
+  recording.save(path);
+
+  ez::odom_recording_header header;
+  std::vector<ez::odom_recording_frame> frames;
+  std::vector<ez::odom_tracker_config> configs;
+  ez::odom_recording_read(path, &header, &frames, &configs);
+  ez::odom_replay_result result = ez::odom_replay(header, frames, configs);
+
+  fusion_result output = {0.0, 0.0, 0.0, 0.0};
+  for (std::size_t i = 0; i < result.trace.size(); i++) {
+    output.worst_fused = fmax(output.worst_fused, fabs(result.trace[i].theta - headings[i]));
+    output.worst_wheel = fmax(output.worst_wheel, fabs(wheel_headings[i] - headings[i]));
+  }
+  output.imu_error = imu_headings.back() - headings.back();
+  output.fused_error = result.trace.back().theta - headings.back();
+  return output;
+}
+
+int main() {
+  fusion_result r5 = record_and_replay(5, 0.2);
+  fusion_result r10 = record_and_replay(10, 0.2);
+  fusion_result r20 = record_and_replay(20, 0.2);
+  std::printf("  after 20s the IMU is %.2f deg off and the wheels are %.1f deg off\n", r5.imu_error, r5.worst_wheel);
+  std::printf("  fused heading ends 5ms %.3f, 10ms %.3f, 20ms %.3f deg off, worst %.3f deg\n", r5.fused_error, r10.fused_error, r20.fused_error, r5.worst_fused);
+
+  check(fabs(r5.fused_error) < fabs(r5.imu_error) / 4.0, "the fused heading beats a drifting IMU");
+  check(r5.worst_fused < 1.0, "wheel slip never gets into the fused heading");
+  check(fabs(r5.fused_error - r10.fused_error) < 0.05 && fabs(r5.fused_error - r20.fused_error) < 0.1,
+        "the task period doesn't change the filter");
+
+  fusion_result still = record_and_replay(5, 0.0);
+  std::printf("  without drift the fused heading is at worst %.4f deg off\n", still.worst_fused);
+  check(still.worst_fused < 0.05, "an IMU that doesn't drift is left alone");
+
+  return failures == 0 ? 0 : 1;
+}
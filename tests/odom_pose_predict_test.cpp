@@ -0,0 +1,90 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla Public
+License, v. 2.0. If a copy of the MPL was not distributed with this
+file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+// Drives to a point at max speed with a delay between the motors being told something and doing it,
+// steering with the measured pose and then with the pose predicted the way Drive::odom_pose_predict_at() does.
+
+#include <cmath>
+#include <cstdio>
+#include <deque>
+
+#include "EZ-Template/odom_tracker.hpp"
+
+static int failures = 0;
+static void check(bool passed, const char* name) {
+  std::printf("%s %s\n", passed ? "pass" : "FAIL", name);
+  if (!passed) failures++;
+}
+
+struct drive_result {
+  double overshoot;  // how far past the target the robot went, in inches
+  double settle;     // seconds until the robot stays within 0.5in of the target
+};
+
+static drive_result drive_to_point(int latency_ms) {
+  const double heading = 30.0;      // degrees, the robot drives straight along this
+  const double target = 48.0;       // inches along the heading
+  const double max_speed = 60.0;    // in/s
+  const double kp = 10.0;           // in/s per inch of error
+  const int motor_delay_ms = 30;    // time before a command reaches the wheels
+  const double motor_time = 0.05;   // seconds for the wheels to get 63% of the way to a new speed
+  const int period_ms = 10;         // odom and motion tasks
+  const int window_ms = 30;         // same window Drive uses
+
+  double distance = 0.0, speed = 0.0, most = 0.0, settle = 0.0;
+  std::deque<double> commands(motor_delay_ms, 0.0);
+  std::deque<ez::pose> history;
+  double command = 0.0;
+  double sin_h = sin(heading * (M_PI / 180)), cos_h = cos(heading * (M_PI / 180));
+
+  for (int time = 0; time < 4000; time++) {
+    if (time % period_ms == 0) {
+      // Odom task, then the motion steers with the newest pose or the predicted one
+      history.push_back({distance * sin_h, distance * cos_h, heading});
+      if ((int)history.size() > (window_ms / period_ms) + 1) history.pop_front();
+      ez::pose used = history.back();
+      if (latency_ms > 0 && history.size() > 1)
+        used = ez::odom_pose_extrapolate(history.front(), history.back(), (history.size() - 1) * period_ms / 1000.0, latency_ms / 1000.0);
+
+      double error = target - ((used.x * sin_h) + (used.y * cos_h));
+      command = fmax(-max_speed, fmin(max_speed, kp * error));
+    }
+
+    // The wheels get old commands and take time to speed up
+    commands.push_back(command);
+    double applied = commands.front();
+    commands.pop_front();
+    speed += (applied - speed) * (0.001 / (motor_time + 0.001));
+    distance += speed * 0.001;
+    most = fmax(most, distance);
+    if (fabs(target - distance) > 0.5) settle = (time + 1) / 1000.0;
+  }
+  return {most - target, settle};
+}
+
+int main() {
+  drive_result measured = drive_to_point(0);
+  drive_result predicted = drive_to_point(80);
+  std::printf("  steering with the measured pose overshoots %.3f in and settles in %.3f s\n", measured.overshoot, measured.settle);
+  std::printf("  steering with an 80ms prediction overshoots %.3f in and settles in %.3f s\n", predicted.overshoot, predicted.settle);
+
+  check(measured.overshoot > 1.0, "latency makes the robot overshoot");
+  check(predicted.overshoot < measured.overshoot * 0.25, "the prediction takes most of the overshoot out");
+  check(predicted.settle < measured.settle * 1.25, "the prediction doesn't slow down settling much");
+
+  // Straight lines and arcs are followed exactly
+  ez::pose past = {0.0, 0.0, 0.0}, newest = {0.0, 1.0, 0.0};
+  ez::pose ahead = ez::odom_pose_extrapolate(past, newest, 0.01, 0.02);
+  check(fabs(ahead.x) < 1e-9 && fabs(ahead.y - 3.0) < 1e-9, "a straight line keeps going");
+
+  // Quarter of a circle of radius 10 per second, turning right from facing +y at the origin
+  auto on_circle = [](double angle) { return ez::pose{10.0 - (10.0 * cos(angle * (M_PI / 180))), 10.0 * sin(angle * (M_PI / 180)), angle}; };
+  ahead = ez::odom_pose_extrapolate(on_circle(0.0), on_circle(9.0), 0.1, 0.2);
+  ez::pose real = on_circle(27.0);
+  check(hypot(ahead.x - real.x, ahead.y - real.y) < 0.01 && fabs(ahead.theta - real.theta) < 1e-9, "an arc keeps curving");
+
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,88 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla Public
+License, v. 2.0. If a copy of the MPL was not distributed with this
+file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+// Records two minutes of driving around through odom_tracker, going through the arc, exponential map and
+// least squares integrators.  `make precision` builds this with EZ_TEMPLATE_ODOM_PRECISION=1 so the recording
+// is the double precision answer, then replays it at every precision to see how far each one drifts.
+//
+//   odom_precision_log <recording>
+
+#include <cmath>
+#include <cstdio>
+
+#include "EZ-Template/odom_tracker.hpp"
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    std::printf("usage: %s <recording>\n", argv[0]);
+    return 2;
+  }
+  const int ticks = 12000;  // 10ms each
+
+  // Left and right tracking wheels 6in from the center, and a back one 3in behind it
+  ez::odom_tracker_config config;
+  config.tracker_left = true;
+  config.tracker_right = true;
+  config.tracker_back = true;
+  config.tracker_left_width = -6.0;
+  config.tracker_right_width = 6.0;
+  config.tracker_back_width = 3.0;
+
+  ez::odom_tracker tracker;
+  tracker.config_set(config);
+  ez::odom_recording recording;
+  recording.start(ticks + 8, tracker.config_get(), tracker.state_get());
+
+  double left = 0.0, right = 0.0, back = 0.0, imu = 0.0;
+  ez::pose end;
+  for (int i = 0; i < ticks; i++) {
+    // Speed and turning keep changing like a match, with a little sideways slide in the turns
+    double t = i * 0.01;
+    double forward = 0.6 * sin(t * 0.7) + 0.25 * sin(t * 2.3);   // in per tick
+    double turn = 0.02 * sin(t * 0.45) + 0.012 * sin(t * 1.9);   // rad per tick, counterclockwise
+    double sideways = 0.05 * turn * forward / 0.02;             // in per tick, to the right
+    left += forward - (6.0 * turn);
+    right += forward + (6.0 * turn);
+    back += sideways + (3.0 * turn);
+    imu -= turn * (180 / M_PI);
+
+    // Go through every integrator, the fused heading comes in with the exponential map
+    if (i == ticks / 3) {
+      config.integrator = 1;
+      config.fused_heading = true;
+    }
+    if (i == 2 * ticks / 3) {
+      config.integrator = 2;
+      config.least_squares_count = 3;
+      config.least_squares[0] = ez::odom_least_squares_sensor_make(-6.0, 0.0, 0.0);
+      config.least_squares[1] = ez::odom_least_squares_sensor_make(6.0, 0.0, 0.0);
+      config.least_squares[2] = ez::odom_least_squares_sensor_make(0.0, -3.0, 90.0);
+    }
+
+    ez::odom_recording_frame tick;
+    tick.input.time = (std::uint64_t)i * 10000;
+    tick.input.tracker_left = left;
+    tick.input.tracker_right = right;
+    tick.input.tracker_back = back;
+    tick.input.imu = imu;
+    tick.input.least_squares[0] = left;
+    tick.input.least_squares[1] = right;
+    tick.input.least_squares[2] = back;
+
+    tracker.config_set(config);
+    recording.config_record(tick.input.time, tracker.config_get());
+    tick.output = tracker.iterate(tick.input);
+    recording.record(tick);
+    end = tick.output;
+  }
+
+  if (!recording.save(argv[1])) {
+    std::printf("Couldn't write %s!\n", argv[1]);
+    return 2;
+  }
+  std::printf("%d ticks recorded, ended near (%.1f, %.1f)\n", ticks, end.x, end.y);
+  return 0;
+}
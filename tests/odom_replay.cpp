@@ -0,0 +1,55 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla Public
+License, v. 2.0. If a copy of the MPL was not distributed with this
+file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+// Replays a recording from Drive::odom_recording_save() on a computer.
+// Exits with 1 when the replay strays from what the robot got by more than the tolerance.
+//
+//   odom_replay <recording> [tolerance in inches] [csv output]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "EZ-Template/odom_tracker.hpp"
+
+static std::uint64_t clock_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    std::printf("usage: %s <recording> [tolerance in inches] [csv output]\n", argv[0]);
+    return 2;
+  }
+  double tolerance = argc > 2 ? std::atof(argv[2]) : 0.01;
+
+  ez::odom_recording_header header;
+  std::vector<ez::odom_recording_frame> frames;
+  std::vector<ez::odom_tracker_config> configs;
+  if (!ez::odom_recording_read(argv[1], &header, &frames, &configs)) {
+    std::printf("Couldn't read %s, or it's from a different version!\n", argv[1]);
+    return 2;
+  }
+
+  ez::odom_replay_result result = ez::odom_replay(header, frames, configs, clock_ns);
+  std::size_t ticks = result.trace.size();
+  std::printf("%zu frames, %zu ticks, %zu config changes\n", frames.size(), ticks, configs.size());
+  std::printf("max error %f in, max theta error %f deg\n", result.max_error, result.max_theta_error);
+  if (ticks > 0)
+    std::printf("iterate %.0f ns average, %llu ns max\n", (double)result.total_time / ticks, (unsigned long long)result.max_time);
+
+  if (argc > 3) {
+    std::FILE* csv = std::fopen(argv[3], "w");
+    if (!csv) {
+      std::printf("Couldn't write %s!\n", argv[3]);
+      return 2;
+    }
+    ez::odom_replay_csv_write(frames, result, csv);
+    std::fclose(csv);
+  }
+
+  return result.max_error > tolerance ? 1 : 0;
+}
@@ -0,0 +1,89 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla Public
+License, v. 2.0. If a copy of the MPL was not distributed with this
+file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+// Records a drive through odom_tracker the way Drive does, changing the setup partway through,
+// then saves, reads and replays it.  The recording is left in bin/ for the odom_replay tool.
+
+#include <cmath>
+#include <cstdio>
+
+#include "EZ-Template/odom_tracker.hpp"
+
+static int failures = 0;
+static void check(bool passed, const char* name) {
+  std::printf("%s %s\n", passed ? "pass" : "FAIL", name);
+  if (!passed) failures++;
+}
+
+int main() {
+  const char* path = "bin/odom_replay_test.bin";
+
+  ez::odom_tracker_config config;
+  config.ime_width_left = -6.0;
+  config.ime_width_right = 6.0;
+
+  ez::odom_tracker tracker;
+  tracker.config_set(config);
+  ez::odom_recording recording;
+  recording.start(2000, tracker.config_get(), tracker.state_get());
+
+  // Drive forwards while turning left, like Drive::ez_tracking_task() would see it
+  double left = 0.0, right = 0.0, back = 0.0, imu = 0.0;
+  for (int i = 0; i < 1000; i++) {
+    left += 0.20;
+    right += 0.25;
+    back += 0.01;
+    imu -= (0.05 / 12.0) * (180 / M_PI);
+
+    // Switch to the fused exponential map with a back tracker partway through, then to least squares
+    if (i == 300) {
+      config.integrator = 1;
+      config.fused_heading = true;
+      config.tracker_back = true;
+      config.tracker_back_width = 3.0;
+    }
+    if (i == 600) {
+      config.integrator = 2;
+      config.least_squares_count = 2;
+      config.least_squares[0] = ez::odom_least_squares_sensor_make(-6.0, 0.0, 0.0);
+      config.least_squares[1] = ez::odom_least_squares_sensor_make(6.0, 0.0, 0.0);
+    }
+
+    ez::odom_recording_frame tick;
+    tick.input.time = i * 10000;
+    tick.input.left = left;
+    tick.input.right = right;
+    tick.input.tracker_back = back;
+    tick.input.imu = imu;
+    tick.input.least_squares[0] = left;
+    tick.input.least_squares[1] = right;
+
+    tracker.config_set(config);
+    recording.config_record(tick.input.time, tracker.config_get());
+    tick.output = tracker.iterate(tick.input);
+    recording.record(tick);
+  }
+  check(recording.save(path), "save");
+
+  ez::odom_recording_header header;
+  std::vector<ez::odom_recording_frame> frames;
+  std::vector<ez::odom_tracker_config> configs;
+  check(ez::odom_recording_read(path, &header, &frames, &configs), "read");
+  check(frames.size() == 1002, "every tick and config change is a frame");
+  check(configs.size() == 2, "only changes are recorded");
+
+  ez::odom_replay_result result = ez::odom_replay(header, frames, configs);
+  check(result.trace.size() == 1000, "every tick is replayed");
+  check(result.max_error == 0.0 && result.max_theta_error == 0.0, "replay matches the recording");
+  std::printf("  max error %g in, %g deg\n", result.max_error, result.max_theta_error);
+
+  // Without the config changes the replay strays, which is what the config frames are for
+  ez::odom_replay_result stale = ez::odom_replay(header, frames, {});
+  check(stale.max_error > 0.1, "replay without config changes strays");
+  std::printf("  max error without them %g in\n", stale.max_error);
+
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,94 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla Public
+License, v. 2.0. If a copy of the MPL was not distributed with this
+file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+// Counts every allocation while a PID runs its exit conditions through the std::span overloads.
+// Those run every loop on the brain, so they shouldn't allocate at all.
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <span>
+
+#include "EZ-Template/PID.hpp"
+
+static int failures = 0;
+static void check(bool passed, const char* name) {
+  std::printf("%s %s\n", passed ? "pass" : "FAIL", name);
+  if (!passed) failures++;
+}
+
+static long allocations = 0;
+
+void* operator new(std::size_t size) {
+  allocations++;
+  void* p = std::malloc(size == 0 ? 1 : size);
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+void* operator new[](std::size_t size) { return operator new(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+  allocations++;
+  return std::malloc(size == 0 ? 1 : size);
+}
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept { return operator new(size, tag); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+extern bool pros_stub_over_current;  // pros_stub.cpp
+
+int main() {
+  ez::PID pid(0.5, 0.01, 2.0, 5.0, "alloc test");
+  pid.exit_condition_set(80, 1.0, 250, 3.0, 500, 500);
+  long setup = allocations;
+  pid.telemetry_enable(256);
+  check(allocations > setup, "the counter sees allocations");
+
+  const std::int8_t ports[] = {1, -2, 3};
+  bool over_current[3] = {false, false, false};
+  std::span<const std::int8_t> port_span(ports);
+  std::span<const bool> over_current_span(over_current);
+
+  // Move back and forth, stalling against something every 4th move so the mA exit runs too
+  int exits = 0;
+  int ends[ez::mA_EXIT + 1] = {};
+  double current = 0.0, speed = 0.0;
+  std::uint64_t time = 1;
+  long before = allocations;
+  for (int move = 0; move < 40; move++) {
+    bool stall = move % 4 == 3;
+    pid.variables_reset();
+    pid.target_set(move % 2 == 0 ? 24.0 : -12.0);
+    for (int tick = 0; tick < 1000; tick++) {
+      double output = pid.compute(current, time);
+      if (stall) output = 0.0;
+      speed += (output - speed) * 0.2;
+      current += speed * 0.05;
+      time += 10000;
+
+      over_current[tick % 3] = stall;
+      pros_stub_over_current = stall;
+      ez::exit_output from_bools = pid.exit_condition(over_current_span);
+      ez::exit_output from_ports = pid.exit_condition(port_span);
+      ez::exit_output exit = from_bools != ez::RUNNING ? from_bools : from_ports;
+      if (exit != ez::RUNNING) {
+        exits++;
+        if (exit >= 0 && exit <= ez::mA_EXIT) ends[exit]++;
+        break;
+      }
+    }
+  }
+  long during = allocations - before;
+
+  std::printf("  %d of 40 moves exited (small %d, big %d, velocity %d, mA %d), %ld allocations\n", exits, ends[ez::SMALL_EXIT],
+              ends[ez::BIG_EXIT], ends[ez::VELOCITY_EXIT], ends[ez::mA_EXIT], during);
+  check(exits == 40, "every move exits");
+  check(ends[ez::mA_EXIT] > 0 && ends[ez::SMALL_EXIT] + ends[ez::BIG_EXIT] > 0, "both the error and mA exits ran");
+  check(during == 0, "exit conditions and compute don't allocate");
+
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,97 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla Public
+License, v. 2.0. If a copy of the MPL was not distributed with this
+file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+// Runs PID_T<double>, PID_T<float> and PID_T<fixed_q16> over the same sensor trace and compares
+// how long each compute takes and how far float and Q16.16 outputs get from double.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "EZ-Template/PID.hpp"
+
+struct reading {
+  double current;
+  std::uint64_t time;
+};
+
+// Drives to 48in and back a few times with a double PID, reading the encoder every 10ms give or take 0.5ms
+static std::vector<reading> trace_make() {
+  std::vector<reading> trace;
+  ez::PID pid(20.0, 0.05, 100.0, 3.0);
+  pid.derivative_filter_set(20.0);
+  pid.integral_limit_set(500.0);
+  double position = 0.0, speed = 0.0;
+  std::uint64_t time = 1000000;
+  unsigned seed = 7;
+  for (int move = 0; move < 10; move++) {
+    pid.variables_reset();
+    pid.target_set(move % 2 == 0 ? 48.0 : 0.0);
+    for (int tick = 0; tick < 300; tick++) {
+      seed = (seed * 1103515245) + 12345;
+      time += 9500 + ((seed >> 16) % 1001);
+      double current = std::round(position * 100.0) / 100.0;  // encoder resolution
+      trace.push_back({current, time});
+      double output = std::clamp(pid.compute(current, time), -127.0, 127.0);
+      speed += (output * 0.5 - speed) * 0.1;
+      position += speed * 0.01;
+    }
+  }
+  return trace;
+}
+
+template <typename Scalar>
+static std::vector<double> outputs_get(const std::vector<reading>& trace, double* ns) {
+  std::vector<double> outputs(trace.size());
+  *ns = 1e9;
+  // Best of a few runs, so other things on the computer don't count
+  for (int run = 0; run < 5; run++) {
+    ez::PID_T<Scalar> pid(20.0, 0.05, 100.0, 3.0);
+    pid.derivative_filter_set(20.0);
+    pid.integral_limit_set(500.0);
+    auto start = std::chrono::steady_clock::now();
+    for (int repeat = 0; repeat < 20; repeat++) {
+      for (std::size_t n = 0; n < trace.size(); n++) {
+        if (n % 300 == 0) {
+          pid.variables_reset();
+          pid.target_set((n / 300) % 2 == 0 ? 48.0 : 0.0);
+        }
+        outputs[n] = static_cast<double>(pid.compute(Scalar(trace[n].current), trace[n].time));
+      }
+    }
+    auto end = std::chrono::steady_clock::now();
+    *ns = std::min(*ns, std::chrono::duration<double, std::nano>(end - start).count() / (trace.size() * 20));
+  }
+  return outputs;
+}
+
+static void compare(const char* name, double ns, const std::vector<double>& outputs, const std::vector<double>& reference) {
+  double worst = 0.0, squares = 0.0, drift = 0.0;
+  for (std::size_t n = 0; n < outputs.size(); n++) {
+    double off = outputs[n] - reference[n];
+    worst = std::max(worst, std::fabs(off));
+    squares += off * off;
+    drift += off;
+  }
+  std::printf("%s, %.1f, %.6f, %.6f, %.4f\n", name, ns, worst, std::sqrt(squares / outputs.size()), drift);
+}
+
+int main() {
+  std::vector<reading> trace = trace_make();
+  std::printf("%zu computes, 10 moves of 48in\n", trace.size());
+  std::printf("type, ns per compute, max output error, rms output error, summed output error\n");
+
+  double ns;
+  std::vector<double> reference = outputs_get<double>(trace, &ns);
+  compare("double", ns, reference, reference);
+  std::vector<double> floats = outputs_get<float>(trace, &ns);
+  compare("float", ns, floats, reference);
+  std::vector<double> fixed = outputs_get<ez::fixed_q16>(trace, &ns);
+  compare("fixed_q16", ns, fixed, reference);
+  return 0;
+}
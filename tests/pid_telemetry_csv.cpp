@@ -0,0 +1,41 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla Public
+License, v. 2.0. If a copy of the MPL was not distributed with this
+file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+// Turns a file from PID::telemetry_get().save() into CSV on a computer.
+//
+//   pid_telemetry_csv <telemetry> [csv output, stdout when left out]
+
+#include <cstdio>
+
+#include "EZ-Template/pid_telemetry.hpp"
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    std::printf("usage: %s <telemetry> [csv output]\n", argv[0]);
+    return 2;
+  }
+
+  std::vector<ez::pid_sample> samples;
+  if (!ez::pid_telemetry_read(argv[1], &samples)) {
+    std::fprintf(stderr, "Couldn't read %s, or it's from a different version!\n", argv[1]);
+    return 2;
+  }
+
+  if (argc < 3) {
+    ez::pid_telemetry_csv_write(samples, stdout);
+    return 0;
+  }
+
+  std::FILE* csv = std::fopen(argv[2], "w");
+  if (!csv) {
+    std::fprintf(stderr, "Couldn't write %s!\n", argv[2]);
+    return 2;
+  }
+  ez::pid_telemetry_csv_write(samples, csv);
+  std::fclose(csv);
+  std::printf("%zu samples written to %s\n", samples.size(), argv[2]);
+  return 0;
+}
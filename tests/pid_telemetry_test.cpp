@@ -0,0 +1,87 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla Public
+License, v. 2.0. If a copy of the MPL was not distributed with this
+file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+// Records more samples than fit, saves them, reads them back and checks nothing changed on the way.
+// The save is left in bin/ for `make check` to turn into CSV with pid_telemetry_csv.
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#include "EZ-Template/pid_telemetry.hpp"
+
+static int failures = 0;
+static void check(bool passed, const char* name) {
+  std::printf("%s %s\n", passed ? "pass" : "FAIL", name);
+  if (!passed) failures++;
+}
+
+static bool same(const ez::pid_sample& a, const ez::pid_sample& b) {
+  return a.time == b.time && a.target == b.target && a.current == b.current && a.error == b.error && a.p == b.p && a.i == b.i &&
+         a.d == b.d && a.output == b.output && a.small_exit_timer == b.small_exit_timer && a.big_exit_timer == b.big_exit_timer &&
+         a.velocity_exit_timer == b.velocity_exit_timer && a.mA_exit_timer == b.mA_exit_timer;
+}
+
+// Something that looks like a PID settling on a target, with every field different
+static ez::pid_sample sample_at(int n) {
+  ez::pid_sample sample;
+  sample.time = 1000000 + ((std::uint64_t)n * 10000);
+  sample.target = 24.0f;
+  sample.current = 24.0f * (1.0f - std::exp(-n / 50.0f));
+  sample.error = sample.target - sample.current;
+  sample.p = sample.error * 0.45f;
+  sample.i = n * 0.001f;
+  sample.d = -std::exp(-n / 50.0f) * 0.3f;
+  sample.output = sample.p + sample.i + sample.d;
+  sample.small_exit_timer = n % 90;
+  sample.big_exit_timer = n % 250;
+  sample.velocity_exit_timer = n % 500;
+  sample.mA_exit_timer = 0;
+  return sample;
+}
+
+int main() {
+  const char* path = "bin/pid_telemetry_test.bin";
+  const int kept = 200, recorded = 500;
+
+  ez::pid_telemetry telemetry;
+  telemetry.resize(kept);
+  for (int n = 0; n < recorded; n++) telemetry.record(sample_at(n));
+  check(telemetry.size() == kept, "only the newest samples are kept");
+
+  check(telemetry.save(path), "save");
+  std::vector<ez::pid_sample> read;
+  check(ez::pid_telemetry_read(path, &read), "read");
+  check((int)read.size() == kept, "every kept sample is saved");
+
+  // Oldest first, starting at the first one that wasn't overwritten
+  bool matches = (int)read.size() == kept;
+  for (int n = 0; matches && n < kept; n++) matches = same(read[n], sample_at(recorded - kept + n));
+  check(matches, "samples read back are the ones recorded");
+
+  // CSV has a header and a line per sample, with time in seconds
+  std::FILE* csv = std::tmpfile();
+  ez::pid_telemetry_csv_write(read, csv);
+  std::rewind(csv);
+  char line[256];
+  int lines = 0;
+  double first_time = 0.0, first_target = 0.0;
+  while (std::fgets(line, sizeof(line), csv)) {
+    if (lines == 1) std::sscanf(line, "%lf,%lf", &first_time, &first_target);
+    lines++;
+  }
+  std::fclose(csv);
+  check(lines == kept + 1, "CSV has a line per sample");
+  check(std::fabs(first_time - (read[0].time / 1000000.0)) < 1e-6 && first_target == 24.0, "CSV starts with the oldest sample");
+
+  // Files that aren't telemetry are turned down
+  std::FILE* wrong = std::fopen("bin/pid_telemetry_wrong.bin", "wb");
+  std::fputs("EZOR not telemetry", wrong);
+  std::fclose(wrong);
+  check(!ez::pid_telemetry_read("bin/pid_telemetry_wrong.bin", &read) && read.empty(), "other files aren't read");
+
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,31 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla Public
+License, v. 2.0. If a copy of the MPL was not distributed with this
+file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+// Stand-ins for the few PROS calls PID.cpp makes, so it can be linked and run on a computer.
+// Motors are never over current unless a test says so with pros_stub_over_current.
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include "EZ-Template/util.hpp"
+
+bool pros_stub_over_current = false;
+
+extern "C" {
+uint64_t micros(void) {
+  static auto start = std::chrono::steady_clock::now();
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+int32_t motor_is_over_current(int8_t) { return pros_stub_over_current ? 1 : 0; }
+int32_t usd_is_installed(void) { return 0; }
+}
+
+namespace pros::usd {
+std::int32_t is_installed(void) { return 0; }
+}  // namespace pros::usd
+
+std::string ez::exit_to_string(ez::exit_output input) { return std::to_string((int)input); }
@@ -0,0 +1,127 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla Public
+License, v. 2.0. If a copy of the MPL was not distributed with this
+file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+// Runs the relay experiment against a simulated mechanism, K e^(-Ls) / ((T1 s + 1)(T2 s + 1)),
+// and compares what it finds with the ultimate gain and period worked out from the plant itself.
+
+#include <cmath>
+#include <cstdio>
+#include <deque>
+
+#include "EZ-Template/relay_autotuner.hpp"
+
+static int failures = 0;
+static void check(bool passed, const char* name) {
+  std::printf("%s %s\n", passed ? "pass" : "FAIL", name);
+  if (!passed) failures++;
+}
+
+struct plant {
+  double gain;    // K, sensor units per unit of output
+  double time_1;  // T1, seconds
+  double time_2;  // T2, seconds
+  double delay;   // L, seconds
+};
+
+// Frequency where the plant lags half a turn, found with bisection
+static double crossover(const plant& p) {
+  double low = 1e-3, high = M_PI / p.delay;
+  for (int i = 0; i < 200; i++) {
+    double w = (low + high) / 2.0;
+    double phase = (w * p.delay) + atan(w * p.time_1) + atan(w * p.time_2);
+    if (phase < M_PI)
+      low = w;
+    else
+      high = w;
+  }
+  return (low + high) / 2.0;
+}
+
+static double ultimate_gain(const plant& p, double w) {
+  return sqrt(1.0 + (w * w * p.time_1 * p.time_1)) * sqrt(1.0 + (w * w * p.time_2 * p.time_2)) / p.gain;
+}
+
+// Runs the experiment with the sensor read and the output sent every loop_ms, the plant moves every 0.1ms
+static ez::relay_autotuner::Result run(const plant& p, int loop_ms, double noise, double hysteresis, ez::e_autotune_state* state) {
+  const double step = 0.0001;
+  const double relay = 50.0;
+  const double target = 0.0;
+
+  ez::relay_autotuner tuner;
+  tuner.loop_time_set(loop_ms);
+  tuner.timeout_set(30000);
+  tuner.initialize(target, relay, hysteresis, 6);
+
+  std::deque<double> delayed((int)round(p.delay / step), 0.0);
+  double x1 = 0.0, x2 = 0.0, output = 0.0;
+  unsigned seed = 1;
+  int loop_steps = loop_ms * 10;
+  for (int i = 0; i < 300000 && tuner.state_get() == ez::AUTOTUNE_RUNNING; i++) {
+    if (i % loop_steps == 0) {
+      // Small repeatable noise on the sensor
+      seed = (seed * 1103515245) + 12345;
+      double sensor = x2 + (noise * ((((seed >> 16) & 0x7fff) / 16383.5) - 1.0));
+      output = tuner.iterate(sensor, (std::uint64_t)i * 100 + 1);
+    }
+
+    delayed.push_back(output);
+    double applied = delayed.front();
+    delayed.pop_front();
+    x1 += (p.gain * applied - x1) * (step / p.time_1);
+    x2 += (x1 - x2) * (step / p.time_2);
+  }
+  *state = tuner.state_get();
+  return tuner.result_get();
+}
+
+static double off_by(double found, double expected) { return fabs(found - expected) / expected; }
+
+int main() {
+  const plant mechanism = {2.0, 0.3, 0.1, 0.05};
+  double w = crossover(mechanism);
+  double ku = ultimate_gain(mechanism, w);
+  double tu = (2.0 * M_PI) / w;
+  std::printf("  plant has Ku %.4f and Tu %.4f s\n", ku, tu);
+
+  // A fast loop with a clean sensor should land close to the plant, the relay method is an approximation
+  ez::e_autotune_state state;
+  ez::relay_autotuner::Result fast = run(mechanism, 1, 0.0, 0.0, &state);
+  std::printf("  1ms loop found Ku %.4f (%.1f%% off) and Tu %.4f s (%.1f%% off)\n", fast.ultimate_gain,
+              off_by(fast.ultimate_gain, ku) * 100.0, fast.ultimate_period, off_by(fast.ultimate_period, tu) * 100.0);
+  check(state == ez::AUTOTUNE_DONE, "a 1ms loop finishes");
+  check(off_by(fast.ultimate_gain, ku) < 0.1, "a 1ms loop finds Ku within 10%");
+  check(off_by(fast.ultimate_period, tu) < 0.05, "a 1ms loop finds Tu within 5%");
+
+  // EZ-Template's 10ms loop with a noisy sensor and hysteresis to ride through it
+  ez::relay_autotuner::Result normal = run(mechanism, 10, 0.2, 0.5, &state);
+  std::printf("  10ms loop with noise found Ku %.4f (%.1f%% off) and Tu %.4f s (%.1f%% off)\n", normal.ultimate_gain,
+              off_by(normal.ultimate_gain, ku) * 100.0, normal.ultimate_period, off_by(normal.ultimate_period, tu) * 100.0);
+  check(state == ez::AUTOTUNE_DONE, "a 10ms loop with noise finishes");
+  check(off_by(normal.ultimate_gain, ku) < 0.2, "a 10ms loop with noise finds Ku within 20%");
+  check(off_by(normal.ultimate_period, tu) < 0.15, "a 10ms loop with noise finds Tu within 15%");
+
+  // Classic Ziegler-Nichols, with i and d per 10ms loop
+  double kp = 0.6 * ku;
+  double ki = kp * 0.01 / (0.5 * tu);
+  double kd = kp * (0.125 * tu) / 0.01;
+  std::printf("  ZN from the plant is kp %.4f ki %.5f kd %.4f, found kp %.4f ki %.5f kd %.4f\n", kp, ki, kd, normal.kp, normal.ki, normal.kd);
+  check(off_by(normal.kp, kp) < 0.2, "ZN kp within 20%");
+  check(off_by(normal.ki, ki) < 0.35, "ZN ki within 35%");
+  check(off_by(normal.kd, kd) < 0.35, "ZN kd within 35%");
+  double found_kp = 0.6 * normal.ultimate_gain;
+  check(fabs(normal.kp - found_kp) < 1e-9 && fabs(normal.ki - (found_kp * 0.01 / (0.5 * normal.ultimate_period))) < 1e-9 &&
+            fabs(normal.kd - (found_kp * (0.125 * normal.ultimate_period) / 0.01)) < 1e-9,
+        "ZN gains come from the measured Ku and Tu");
+
+  // Nothing to oscillate against, so the timeout should end it
+  ez::relay_autotuner stuck;
+  stuck.timeout_set(1000);
+  stuck.initialize(100.0, 50.0);
+  for (int time = 0; time <= 2000 && stuck.state_get() == ez::AUTOTUNE_RUNNING; time += 10) stuck.iterate(0.0, (std::uint64_t)time * 1000 + 1);
+  check(stuck.state_get() == ez::AUTOTUNE_FAILED, "a mechanism that never crosses the target times out");
+
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,119 @@
+/*
+This Source Code Form is subject to the terms of the Mozilla Public
+License, v. 2.0. If a copy of the MPL was not distributed with this
+file, You can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+
+// Drives a simulated robot with four distance sensors around the field for 30s, with odometry that starts 3in off
+// and over-reads by 3%.  Corrections are applied the same way Drive::ez_localize_task() applies them.
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+#include "EZ-Template/wall_localizer.hpp"
+
+static int failures = 0;
+static void check(bool passed, const char* name) {
+  std::printf("%s %s\n", passed ? "pass" : "FAIL", name);
+  if (!passed) failures++;
+}
+
+struct localize_result {
+  double converge;      // seconds until odometry stays within 1.5in of the robot
+  double final_error;   // inches between odometry and the robot at the end
+  double worst_error;   // biggest error after converging, in inches
+  double average_time;  // microseconds per predict() and update()
+  double max_time;      // longest predict() and update(), in microseconds
+};
+
+static localize_result localize(bool correct) {
+  const double period = 0.05;   // same as ez_localize_task()
+  const double blend = 0.2;     // Drive's defaults
+  const double spread_max = 3.0;
+
+  ez::wall_localizer localizer;
+  localizer.seed_set(12345);
+  localizer.sensor_add({0.0, 6.0, 0.0});
+  localizer.sensor_add({-6.0, 0.0, -90.0});
+  localizer.sensor_add({6.0, 0.0, 90.0});
+  localizer.sensor_add({0.0, -6.0, 180.0});
+
+  // Readings are +-2% with 0.3in of noise, and one sensor sees something that isn't a wall each update
+  std::mt19937 gen(7);
+  std::normal_distribution<double> noise(0.0, 1.0);
+
+  // Where the robot really is, it loops around inside the field
+  auto path_x = [](double time) { return 45.0 * sin(time * 0.3); };
+  auto path_y = [](double time) { return -10.0 + (40.0 * sin((time * 0.21) + 1.0)); };
+  double x = path_x(0.0), y = path_y(0.0), theta = 0.0;
+  double odom_x = x + 3.0, odom_y = y + 3.0;
+  localizer.reset({odom_x, odom_y, theta}, 2.0);
+  double last_x = odom_x, last_y = odom_y;
+
+  localize_result result = {-1.0, 0.0, 0.0, 0.0, 0.0};
+  int updates = 600;
+  for (int k = 0; k < updates; k++) {
+    double time = k * period;
+    double dx = path_x(time + period) - x;
+    double dy = path_y(time + period) - y;
+    theta = 30.0 * sin(time * 0.2);
+    x += dx;
+    y += dy;
+    odom_x += dx * 1.03;
+    odom_y += dy * 1.03;
+
+    double ranges[4];
+    for (int j = 0; j < 4; j++) {
+      double expected = localizer.expected_range(x, y, theta, j);
+      ranges[j] = expected < 0.0 ? -1.0 : (expected * (1.0 + (0.02 * noise(gen)))) + (0.3 * noise(gen));
+      if (k % 7 == j) ranges[j] = expected * 0.4;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    localizer.predict(odom_x - last_x, odom_y - last_y);
+    last_x = odom_x;
+    last_y = odom_y;
+    bool updated = localizer.update(theta, ranges);
+    double elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    result.average_time += elapsed / updates;
+    result.max_time = fmax(result.max_time, elapsed);
+
+    if (correct && updated && localizer.spread_get() <= spread_max) {
+      ez::pose estimate = localizer.estimate_get();
+      double correct_x = (estimate.x - odom_x) * blend;
+      double correct_y = (estimate.y - odom_y) * blend;
+      odom_x += correct_x;
+      odom_y += correct_y;
+      last_x += correct_x;
+      last_y += correct_y;
+    }
+
+    double error = hypot(odom_x - x, odom_y - y);
+    if (error > 1.5) result.converge = -1.0;
+    else if (result.converge < 0.0) result.converge = time + period;
+    if (result.converge >= 0.0) result.worst_error = fmax(result.worst_error, error);
+    result.final_error = error;
+  }
+  return result;
+}
+
+int main() {
+  localize_result uncorrected = localize(false);
+  localize_result corrected = localize(true);
+  std::printf("  without walls odometry ends %.2fin off\n", uncorrected.final_error);
+  std::printf("  with walls odometry stays within 1.5in after %.2fs, ends %.2fin off, worst %.2fin after converging\n",
+              corrected.converge, corrected.final_error, corrected.worst_error);
+  std::printf("  %.1fus per update on average, %.1fus max, on this computer\n", corrected.average_time, corrected.max_time);
+
+  check(uncorrected.final_error > 3.0, "odometry drifts without walls");
+  check(corrected.converge >= 0.0 && corrected.converge < 3.0, "odometry converges within 3s");
+  check(corrected.final_error < uncorrected.final_error / 3.0, "walls keep odometry on the robot");
+
+  // The same seeds give the same run
+  localize_result again = localize(true);
+  check(again.converge == corrected.converge && again.final_error == corrected.final_error, "runs are repeatable");
+
+  return failures == 0 ? 0 : 1;
+}